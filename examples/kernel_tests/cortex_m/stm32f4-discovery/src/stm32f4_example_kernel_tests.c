@@ -0,0 +1,876 @@
+/*
+ * Copyright (C) 2019 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * File Name  :	stm32f4_example_kernel_tests.c
+ * Description:	stm32f4_example_kernel_tests
+ *
+ * Kernel behaviour checks. The test Thread runs every check in turn and
+ * lights the green LED when all of them pass or the red LED otherwise.
+ * The number of the first failed check is kept in test_failed.
+ *
+ * The benchmarks then run and leave their results (DWT cycles) in the
+ * bench_xxx variables. Build with OS_THREAD_RUNTIME=0 and 1 to get the
+ * cost of runtime accounting on the thread switch path.
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <stdbool.h>
+
+#include "stm32f4xx.h"
+#include "system_stm32f4xx.h"
+#include "RTOS_Config.h"
+#include "ukernel.h"
+
+/*******************************************************************************
+ *  external declarations
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#if (OS_HEAP_SIZE == 0)
+#error "Kernel Heap is required (define OS_HEAP_SIZE in the project options)"
+#endif
+
+#if (OS_MEMALLOC_16_NUM != 1) || (OS_MEMALLOC_64_NUM != 1)
+#error "One 16 and one 64 byte Memory Allocator block are required (OS_MEMALLOC_x_NUM)"
+#endif
+
+#if (OS_THREAD_NUM != 1) || (OS_THREAD_STACK_NUM != 1)
+#error "One pooled Thread and Thread Stack are required (OS_THREAD_NUM, OS_THREAD_STACK_NUM)"
+#endif
+
+#define LED_GREEN           (1UL << 12U)
+#define LED_ORANGE          (1UL << 13U)
+#define LED_RED             (1UL << 14U)
+#define LED_BLUE            (1UL << 15U)
+
+#define WORKER_NUM          (4U)
+#define BENCH_LOOPS         (1000U)
+#define BENCH_CHAIN_LOOPS   (16U)
+#define SETTLE_TIME         (10UL)
+
+/* Armed Timers for the insert benchmark (osTimer_t is 36 bytes, 10000 do not fit the 128 KB RAM) */
+#ifndef BENCH_TIMER_NUM
+#define BENCH_TIMER_NUM     (1000U)
+#endif
+
+#define CHECK(cond)         do { if (!(cond)) { return (false); } } while (0)
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+typedef bool (*test_func_t)(void);
+
+/*******************************************************************************
+ *  global variable definitions  (scope: module-exported)
+ ******************************************************************************/
+
+volatile uint32_t test_failed;
+volatile uint32_t bench_switch_cycles;      /* Thread switch with osThreadFlagsWait return */
+volatile uint32_t bench_chain_cycles;       /* Worst case mutex[0] release to wakeup of the mutex[2] waiter */
+volatile uint32_t bench_thread_cycles;      /* osThreadNew + osThreadExit + osThreadJoin */
+volatile uint32_t bench_thread_rate;        /* Create/exit/join cycles per second */
+volatile uint32_t bench_thread_reuse;       /* 1: every cycle got the same pooled control block and stack */
+volatile uint32_t bench_timer_cycles[4];    /* osTimerStart with 10, 100, 1000 and 10000 armed Timers (0: not run) */
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t         test_thread;
+static osThread_t           test_thread_cb;
+static uint64_t             test_thread_stack[OS_STACK_SIZE/8U];
+static const osThreadAttr_t test_thread_attr = {
+    .name       = NULL,
+    .attr_bits  = 0U,
+    .cb_mem     = &test_thread_cb,
+    .cb_size    = sizeof(test_thread_cb),
+    .stack_mem  = &test_thread_stack[0],
+    .stack_size = sizeof(test_thread_stack),
+    .priority   = osPriorityRealtime,
+};
+
+static osThreadId_t         worker[WORKER_NUM];
+static osThread_t           worker_cb[WORKER_NUM];
+static uint64_t             worker_stack[WORKER_NUM][OS_STACK_SIZE/8U];
+
+static osMutexId_t          mutex[3];
+static osMutex_t            mutex_cb[3];
+
+static osMessageQueue_t     msg_queue_cb;
+static uint32_t             msg_queue_mem[osMessageQueueMemSize(4U, sizeof(uint32_t))/4U];
+static const osMessageQueueAttr_t msg_queue_attr = {
+    .name      = NULL,
+    .attr_bits = 0U,
+    .cb_mem    = &msg_queue_cb,
+    .cb_size   = sizeof(msg_queue_cb),
+    .mq_mem    = &msg_queue_mem[0],
+    .mq_size   = sizeof(msg_queue_mem),
+};
+
+static osDataQueue_t        data_queue_cb;
+static uint32_t             data_queue_mem[8];
+
+static osTimer_t            bench_timer_cb[BENCH_TIMER_NUM + 1U];
+static osTimerId_t          bench_timer[BENCH_TIMER_NUM + 1U];
+
+static osEventFlags_t       event_flags_cb;
+static const osEventFlagsAttr_t event_flags_attr = {
+    .name      = NULL,
+    .attr_bits = 0U,
+    .cb_mem    = &event_flags_cb,
+    .cb_size   = sizeof(event_flags_cb),
+};
+static osEventFlagsId_t     event_flags;
+
+static volatile uint32_t    wake_seq;
+static volatile uint32_t    chain_release;
+static volatile uint32_t    worker_num;
+static uint32_t             worker_data[4];
+static volatile uint32_t    wake_late[WORKER_NUM];
+static volatile osStatus_t  worker_status;
+static void * volatile      worker_ptr;
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+static osThreadId_t WorkerCreate(uint32_t index, osThreadFunc_t func, void *argument, osPriority_t priority, uint32_t attr_bits)
+{
+  osThreadAttr_t attr = {
+      .name       = NULL,
+      .attr_bits  = attr_bits,
+      .cb_mem     = &worker_cb[index],
+      .cb_size    = sizeof(worker_cb[index]),
+      .stack_mem  = &worker_stack[index][0],
+      .stack_size = sizeof(worker_stack[index]),
+      .priority   = priority,
+  };
+
+  worker[index] = osThreadNew(func, argument, &attr);
+  osDelay(SETTLE_TIME);
+
+  return (worker[index]);
+}
+
+static osThreadId_t WorkerStart(uint32_t index, osThreadFunc_t func, void *argument, osPriority_t priority)
+{
+  return (WorkerCreate(index, func, argument, priority, osThreadDetached));
+}
+
+static osMutexId_t MutexCreate(uint32_t index)
+{
+  osMutexAttr_t attr = {
+      .name         = NULL,
+      .attr_bits    = osMutexPrioInherit,
+      .cb_mem       = &mutex_cb[index],
+      .cb_size      = sizeof(mutex_cb[index]),
+      .prio_ceiling = osPriorityNone,
+  };
+
+  mutex[index] = osMutexNew(&attr);
+
+  return (mutex[index]);
+}
+
+/* Hold mutex[n] and wait for mutex[n - 1] (mutex[0] holder waits for a flag) */
+static void MutexChainWorker(void *argument)
+{
+  uint32_t n = (uint32_t)argument;
+
+  osMutexAcquire(mutex[n], osWaitForever);
+  if (n == 0U) {
+    osThreadFlagsWait(1U, osFlagsWaitAny, osWaitForever);
+    chain_release = DWT->CYCCNT;
+  }
+  else {
+    osMutexAcquire(mutex[n - 1U], osWaitForever);
+    osMutexRelease(mutex[n - 1U]);
+  }
+  osMutexRelease(mutex[n]);
+}
+
+static void MutexTimeoutWorker(void *argument)
+{
+  worker_status = osMutexAcquire(mutex[2], 5U * SETTLE_TIME);
+}
+
+/*
+ * Three deep priority inheritance chain: a High Thread waits with timeout for
+ * mutex[2], its owner waits for mutex[1] and so on. All owners inherit High and
+ * drop back to the priority of the remaining waiters when the High Thread
+ * times out.
+ */
+static bool TestMutexChainTimeout(void)
+{
+  static const osPriority_t prio[3] = {osPriorityLow, osPriorityBelowNormal, osPriorityNormal};
+
+  for (uint32_t i = 0U; i < 3U; i++) {
+    CHECK(MutexCreate(i) != NULL);
+  }
+  for (uint32_t i = 0U; i < 3U; i++) {
+    CHECK(WorkerStart(i, MutexChainWorker, (void *)i, prio[i]) != NULL);
+  }
+
+  /* Each owner inherits the priority of the Thread waiting on its Mutex */
+  CHECK(osThreadGetPriority(worker[0]) == osPriorityNormal);
+  CHECK(osThreadGetPriority(worker[1]) == osPriorityNormal);
+
+  worker_status = osOK;
+  CHECK(WorkerStart(3U, MutexTimeoutWorker, NULL, osPriorityHigh) != NULL);
+  for (uint32_t i = 0U; i < 3U; i++) {
+    CHECK(osThreadGetPriority(worker[i]) == osPriorityHigh);
+  }
+
+  /* The High waiter times out, the chain falls back to Normal */
+  osDelay(10U * SETTLE_TIME);
+  CHECK(worker_status == osErrorTimeout);
+  for (uint32_t i = 0U; i < 3U; i++) {
+    CHECK(osThreadGetPriority(worker[i]) == osPriorityNormal);
+  }
+
+  /* Unwind the chain */
+  osThreadFlagsSet(worker[0], 1U);
+  osDelay(SETTLE_TIME);
+  for (uint32_t i = 0U; i < 3U; i++) {
+    CHECK(osMutexGetOwner(mutex[i]) == NULL);
+    CHECK(osMutexDelete(mutex[i]) == osOK);
+  }
+
+  return (true);
+}
+
+static void HeapLargeWorker(void *argument)
+{
+  worker_status = (osHeapAlloc((uint32_t)argument, 5U * SETTLE_TIME) == NULL) ? osErrorTimeout : osOK;
+}
+
+static void HeapSmallWorker(void *argument)
+{
+  worker_ptr = osHeapAlloc((uint32_t)argument, osWaitForever);
+}
+
+/*
+ * Kernel Heap: allocation of the whole heap, detection of a double free and
+ * of a pointer into a block, and a queued request that is served when the
+ * waiter in front of it times out.
+ */
+static bool TestHeap(void)
+{
+  osHeapStats_t stats;
+  uint8_t      *p1;
+  uint8_t      *p2;
+
+  CHECK(osHeapGetStats(&stats) == osOK);
+  CHECK((stats.total_size != 0U) && (stats.free_size == stats.total_size));
+
+  /* The whole heap is one block from the list of its own size */
+  p1 = osHeapAlloc(stats.total_size, 0U);
+  CHECK(p1 != NULL);
+  CHECK(osHeapFree(p1) == osOK);
+
+  p1 = osHeapAlloc(100U, 0U);
+  p2 = osHeapAlloc(200U, 0U);
+  CHECK((p1 != NULL) && (p2 != NULL));
+  CHECK(osHeapFree(p1) == osOK);
+  CHECK(osHeapFree(p1) == osErrorResource);
+  CHECK(osHeapFree(p2 + 8U) == osErrorResource);
+  CHECK(osHeapFree(p2) == osOK);
+  CHECK(osHeapFree(p2) == osErrorResource);
+
+  CHECK(osHeapGetStats(&stats) == osOK);
+  CHECK((stats.free_size == stats.total_size) && (stats.used_blocks == 0U) && (stats.free_blocks == 1U));
+
+  /* A large waiter blocks a small one until it times out */
+  p1 = osHeapAlloc(stats.total_size - 256U, 0U);
+  CHECK(p1 != NULL);
+  worker_status = osOK;
+  worker_ptr = NULL;
+  CHECK(WorkerStart(0U, HeapLargeWorker, (void *)512U, osPriorityHigh) != NULL);
+  CHECK(WorkerStart(1U, HeapSmallWorker, (void *)64U, osPriorityNormal) != NULL);
+  CHECK(worker_ptr == NULL);
+
+  osDelay(10U * SETTLE_TIME);
+  CHECK((worker_status == osErrorTimeout) && (worker_ptr != NULL));
+  CHECK(osHeapFree(worker_ptr) == osOK);
+  CHECK(osHeapFree(p1) == osOK);
+
+  return (true);
+}
+
+static void MemWorker(void *argument)
+{
+  worker_ptr = osMemAlloc((uint32_t)argument, osWaitForever);
+}
+
+/*
+ * Memory Allocator: a 16 byte request borrows the 64 byte block when its own
+ * class is empty, and a Thread waiting for 16 bytes gets the 64 byte block
+ * when it is released.
+ */
+static bool TestMemAlloc(void)
+{
+  void *p1;
+  void *p2;
+
+  p1 = osMemAlloc(16U, 0U);
+  p2 = osMemAlloc(16U, 0U);
+  CHECK((p1 != NULL) && (p2 != NULL));
+  CHECK(osMemAlloc(16U, 0U) == NULL);
+
+  worker_ptr = NULL;
+  CHECK(WorkerStart(0U, MemWorker, (void *)16U, osPriorityNormal) != NULL);
+  CHECK(worker_ptr == NULL);
+
+  /* The borrowed 64 byte block goes to the waiter of the 16 byte class */
+  CHECK(osMemFree(p2) == osOK);
+  osDelay(SETTLE_TIME);
+  CHECK(worker_ptr == p2);
+
+  CHECK(osMemFree(p2) == osOK);
+  CHECK(osMemFree(p1) == osOK);
+
+  return (true);
+}
+
+/*
+ * Zero-copy Message Queue: Reset drops queued Messages but keeps the held
+ * blocks valid, the dropped blocks are reused, and pointers that are not
+ * held blocks (misaligned, queued or released) are rejected.
+ */
+static bool TestMessageQueueReset(void)
+{
+  osMessageQueueId_t mq;
+  uint32_t          *held;
+  uint32_t          *msg;
+  uint32_t           data = 1U;
+
+  mq = osMessageQueueNew(4U, sizeof(uint32_t), &msg_queue_attr);
+  CHECK(mq != NULL);
+
+  held = osMessageQueueAlloc(mq, 0U);
+  CHECK(held != NULL);
+  CHECK(osMessageQueueRelease(mq, (uint8_t *)held + 4U) == osErrorParameter);
+
+  msg = osMessageQueueAlloc(mq, 0U);
+  CHECK(osMessageQueueSend(mq, msg, 0U) == osOK);
+  CHECK(osMessageQueuePut(mq, &data, 0U, 0U) == osOK);
+  CHECK(osMessageQueueRelease(mq, msg) == osErrorParameter);
+  CHECK(osMessageQueueGetSpace(mq) == 1U);
+
+  /* Queued Messages are dropped, the held block stays allocated */
+  CHECK(osMessageQueueReset(mq) == osOK);
+  CHECK((osMessageQueueGetCount(mq) == 0U) && (osMessageQueueGetSpace(mq) == 3U));
+  CHECK(osMessageQueueRelease(mq, msg) == osErrorParameter);
+
+  for (uint32_t i = 0U; i < 3U; i++) {
+    CHECK(osMessageQueuePut(mq, &data, 0U, 0U) == osOK);
+  }
+  CHECK(osMessageQueuePut(mq, &data, 0U, 0U) == osErrorResource);
+
+  CHECK(osMessageQueueRelease(mq, held) == osOK);
+  CHECK(osMessageQueueRelease(mq, held) == osErrorParameter);
+  CHECK(osMessageQueueDelete(mq) == osOK);
+
+  return (true);
+}
+
+/*
+ * Message Queue priorities: Messages are received highest priority first
+ * and in FIFO order within a priority, across the priority groups.
+ */
+static bool TestMessageQueuePriority(void)
+{
+  static const uint8_t  put_prio[4] = {0U, 200U, 40U, 200U};
+  static const uint32_t get_data[4] = {2U, 4U, 3U, 1U};
+  osMessageQueueId_t    mq;
+  uint32_t              data;
+  uint8_t               prio;
+
+  mq = osMessageQueueNew(4U, sizeof(uint32_t), &msg_queue_attr);
+  CHECK(mq != NULL);
+
+  for (data = 1U; data <= 4U; data++) {
+    CHECK(osMessageQueuePut(mq, &data, put_prio[data - 1U], 0U) == osOK);
+  }
+
+  for (uint32_t i = 0U; i < 4U; i++) {
+    CHECK(osMessageQueueGet(mq, &data, &prio, 0U) == osOK);
+    CHECK((data == get_data[i]) && (prio == put_prio[data - 1U]));
+
+    if (i == 1U) {
+      /* A higher priority Message overtakes the queued ones */
+      data = 5U;
+      CHECK(osMessageQueuePut(mq, &data, 41U, 0U) == osOK);
+      CHECK(osMessageQueueGet(mq, &data, &prio, 0U) == osOK);
+      CHECK((data == 5U) && (prio == 41U));
+    }
+  }
+  CHECK(osMessageQueueGetCount(mq) == 0U);
+  CHECK(osMessageQueueDelete(mq) == osOK);
+
+  return (true);
+}
+
+static bool DataQueueBulk(osDataQueueId_t dq)
+{
+  uint32_t data[16];
+
+  for (uint32_t i = 0U; i < 16U; i++) {
+    data[i] = i + 1U;
+  }
+
+  CHECK(osDataQueuePutN(dq, &data[0], 5U, 0U) == 5U);
+  CHECK(osDataQueueGetN(dq, &data[0], 3U, 0U) == 3U);
+  CHECK((data[0] == 1U) && (data[1] == 2U) && (data[2] == 3U));
+
+  /* Only the free space is filled, the ring wraps around */
+  CHECK(osDataQueuePutN(dq, &data[5], 8U, 0U) == 6U);
+  CHECK(osDataQueuePutN(dq, &data[11], 1U, 0U) == 0U);
+  CHECK(osDataQueueGetCount(dq) == 8U);
+
+  CHECK(osDataQueueGetN(dq, &data[0], 16U, 0U) == 8U);
+  for (uint32_t i = 0U; i < 8U; i++) {
+    CHECK(data[i] == (i + 4U));
+  }
+  CHECK(osDataQueueGetN(dq, &data[0], 16U, 0U) == 0U);
+
+  return (true);
+}
+
+static void DataQueueWorker(void *argument)
+{
+  worker_num = osDataQueueGetN(argument, &worker_data[0], 4U, osWaitForever);
+}
+
+/*
+ * Data Queue bulk transfer: partial puts and gets that wrap around the ring
+ * keep the data in order, for the locked and the osDataQueueSpsc queue, and
+ * a Thread blocked in osDataQueueGetN receives a shorter put at once.
+ */
+static bool TestDataQueueBulk(void)
+{
+  osDataQueueAttr_t  attr = {
+      .name      = NULL,
+      .attr_bits = 0U,
+      .cb_mem    = &data_queue_cb,
+      .cb_size   = sizeof(data_queue_cb),
+      .dq_mem    = &data_queue_mem[0],
+      .dq_size   = sizeof(data_queue_mem),
+  };
+  osDataQueueId_t    dq;
+  uint32_t           data[3] = {7U, 8U, 9U};
+
+  dq = osDataQueueNew(8U, sizeof(uint32_t), &attr);
+  CHECK(dq != NULL);
+  CHECK(DataQueueBulk(dq));
+
+  worker_num = 0U;
+  CHECK(WorkerStart(0U, DataQueueWorker, dq, osPriorityHigh) != NULL);
+  CHECK(osDataQueuePutN(dq, &data[0], 3U, 0U) == 3U);
+  osDelay(SETTLE_TIME);
+  CHECK((worker_num == 3U) && (worker_data[0] == 7U) && (worker_data[2] == 9U));
+  CHECK(osDataQueueGetCount(dq) == 0U);
+  CHECK(osDataQueueDelete(dq) == osOK);
+
+  attr.attr_bits = osDataQueueSpsc;
+  dq = osDataQueueNew(8U, sizeof(uint32_t), &attr);
+  CHECK(dq != NULL);
+  CHECK(DataQueueBulk(dq));
+  CHECK(osDataQueueDelete(dq) == osOK);
+
+  return (true);
+}
+
+static void EventFlagsWorker(void *argument)
+{
+  if (osEventFlagsWait(event_flags, 1U, osFlagsWaitAny, osWaitForever) == 1U) {
+    wake_seq = (wake_seq * 10U) + (uint32_t)argument;
+  }
+}
+
+/*
+ * Event Flags: a waiter whose priority is raised while it waits is woken
+ * before the waiters it overtook.
+ */
+static bool TestEventFlagsPriority(void)
+{
+  event_flags = osEventFlagsNew(&event_flags_attr);
+  CHECK(event_flags != NULL);
+
+  wake_seq = 0U;
+  CHECK(WorkerStart(0U, EventFlagsWorker, (void *)1U, osPriorityLow) != NULL);
+  CHECK(WorkerStart(1U, EventFlagsWorker, (void *)2U, osPriorityBelowNormal) != NULL);
+  CHECK(osThreadSetPriority(worker[0], osPriorityNormal) == osOK);
+
+  /* Each flag wakes one Thread (the flag is cleared by the first waiter) */
+  osEventFlagsSet(event_flags, 1U);
+  osDelay(SETTLE_TIME);
+  CHECK(wake_seq == 1U);
+  osEventFlagsSet(event_flags, 1U);
+  osDelay(SETTLE_TIME);
+  CHECK(wake_seq == 12U);
+
+  CHECK(osEventFlagsDelete(event_flags) == osOK);
+
+  return (true);
+}
+
+/* Delays that end in level 3, 2, 1 and 0 of the timing wheel */
+static const uint32_t       wheel_delay[WORKER_NUM] = {5000U, 300U, 70U, 1U};
+
+static void TimeoutWorker(void *argument)
+{
+  uint32_t index = (uint32_t)argument;
+  uint32_t time;
+
+  time = osKernelGetTickCount() + wheel_delay[index];
+  if (osDelayUntil(time) == osOK) {
+    wake_late[index] = osKernelGetTickCount() - time;
+    wake_seq = (wake_seq * 10U) + index + 1U;
+  }
+}
+
+/*
+ * Timing wheel: Delays linked in different levels are cascaded down and
+ * expire on the exact tick, shortest first.
+ */
+static bool TestTimeoutWheel(void)
+{
+  wake_seq = 0U;
+  for (uint32_t i = 0U; i < WORKER_NUM; i++) {
+    wake_late[i] = 0xFFFFFFFFU;
+    CHECK(WorkerStart(i, TimeoutWorker, (void *)i, osPriorityHigh) != NULL);
+  }
+
+  osDelay(wheel_delay[0] + SETTLE_TIME);
+  CHECK(wake_seq == 4321U);
+  for (uint32_t i = 0U; i < WORKER_NUM; i++) {
+    CHECK(wake_late[i] == 0U);
+  }
+
+  return (true);
+}
+
+static void JoinWorker(void *argument)
+{
+  worker_status = osThreadJoin(worker[(uint32_t)argument]);
+}
+
+static void ExitWorker(void *argument)
+{
+  osDelay((uint32_t)argument);
+}
+
+/*
+ * Thread Join and Detach: a joinable Thread is kept after it exits until it
+ * is joined, a detached Thread cannot be joined, and detaching a Thread
+ * releases the Thread waiting to join it with osErrorResource.
+ */
+static bool TestThreadJoin(void)
+{
+  /* Join a running Thread and a Thread that has already exited */
+  CHECK(WorkerCreate(0U, ExitWorker, (void *)(5U * SETTLE_TIME), osPriorityNormal, osThreadJoinable) != NULL);
+  CHECK(osThreadGetState(worker[0]) == osThreadBlocked);
+  CHECK(osThreadJoin(worker[0]) == osOK);
+  CHECK(osThreadGetState(worker[0]) == osThreadError);
+
+  CHECK(WorkerCreate(0U, ExitWorker, (void *)0U, osPriorityNormal, osThreadJoinable) != NULL);
+  CHECK(osThreadGetState(worker[0]) == osThreadTerminated);
+  CHECK(osThreadJoin(worker[0]) == osOK);
+  CHECK(osThreadJoin(worker[0]) == osErrorParameter);
+
+  /* Detached Threads */
+  CHECK(WorkerStart(0U, ExitWorker, (void *)(5U * SETTLE_TIME), osPriorityNormal) != NULL);
+  CHECK(osThreadJoin(worker[0]) == osErrorResource);
+  CHECK(osThreadDetach(worker[0]) == osErrorResource);
+  osDelay(5U * SETTLE_TIME);
+  CHECK(osThreadGetState(worker[0]) == osThreadError);
+
+  /* Detach a Thread with a pending Join */
+  worker_status = osOK;
+  CHECK(WorkerCreate(0U, ExitWorker, (void *)(10U * SETTLE_TIME), osPriorityNormal, osThreadJoinable) != NULL);
+  CHECK(WorkerStart(1U, JoinWorker, (void *)0U, osPriorityHigh) != NULL);
+  CHECK(osThreadGetState(worker[1]) == osThreadBlocked);
+  CHECK(osThreadDetach(worker[0]) == osOK);
+  osDelay(SETTLE_TIME);
+  CHECK(worker_status == osErrorResource);
+  CHECK(osThreadGetState(worker[0]) == osThreadBlocked);
+
+  osDelay(10U * SETTLE_TIME);
+  CHECK(osThreadGetState(worker[0]) == osThreadError);
+
+  return (true);
+}
+
+static const test_func_t tests[] = {
+    TestMutexChainTimeout,
+    TestHeap,
+    TestMemAlloc,
+    TestMessageQueueReset,
+    TestMessageQueuePriority,
+    TestDataQueueBulk,
+    TestEventFlagsPriority,
+    TestTimeoutWheel,
+    TestThreadJoin,
+};
+
+static void SwitchWorker(void *argument)
+{
+  for (;;) {
+    osThreadFlagsWait(1U, osFlagsWaitAny, osWaitForever);
+  }
+}
+
+static uint32_t BenchFlagsSet(uint32_t flags)
+{
+  uint32_t start = DWT->CYCCNT;
+
+  for (uint32_t i = 0U; i < BENCH_LOOPS; i++) {
+    osThreadFlagsSet(worker[0], flags);
+  }
+
+  return (DWT->CYCCNT - start);
+}
+
+/*
+ * Thread switch: every osThreadFlagsSet wakes a higher priority Thread that
+ * waits again at once, i.e. two switches per loop. The same loop with a
+ * flag that does not wake the Thread is subtracted.
+ */
+static void BenchThreadSwitch(void)
+{
+  uint32_t cycles;
+
+  if (WorkerStart(0U, SwitchWorker, NULL, osPriorityRealtime1) == NULL) {
+    return;
+  }
+
+  cycles  = BenchFlagsSet(1U);
+  cycles -= BenchFlagsSet(2U);
+  bench_switch_cycles = cycles / (2U * BENCH_LOOPS);
+
+  osThreadTerminate(worker[0]);
+}
+
+static void BenchChainWaiter(void *argument)
+{
+  uint32_t cycles;
+
+  osMutexAcquire(mutex[2], osWaitForever);
+  cycles = DWT->CYCCNT - chain_release;
+  if (cycles > bench_chain_cycles) {
+    bench_chain_cycles = cycles;
+  }
+  osMutexRelease(mutex[2]);
+}
+
+/*
+ * Three deep inheritance chain: the High waiter of mutex[2] boosts all
+ * owners, then the owner of mutex[0] releases it and the chain unwinds
+ * through two hand-overs to the waiter. The worst case of the release to
+ * wakeup time over BENCH_CHAIN_LOOPS runs is kept.
+ */
+static void BenchMutexChain(void)
+{
+  static const osPriority_t prio[3] = {osPriorityLow, osPriorityBelowNormal, osPriorityNormal};
+
+  bench_chain_cycles = 0U;
+
+  for (uint32_t loop = 0U; loop < BENCH_CHAIN_LOOPS; loop++) {
+    for (uint32_t i = 0U; i < 3U; i++) {
+      if ((MutexCreate(i) == NULL) ||
+          (WorkerStart(i, MutexChainWorker, (void *)i, prio[i]) == NULL)) {
+        return;
+      }
+    }
+    if (WorkerStart(3U, BenchChainWaiter, NULL, osPriorityHigh) == NULL) {
+      return;
+    }
+
+    osThreadFlagsSet(worker[0], 1U);
+    osDelay(SETTLE_TIME);
+
+    for (uint32_t i = 0U; i < 3U; i++) {
+      osMutexDelete(mutex[i]);
+    }
+  }
+}
+
+static void BenchExitThread(void *argument)
+{
+  uint32_t local;
+
+  worker_ptr = &local;
+  osThreadExit();
+}
+
+/*
+ * Thread life cycle: create a joinable Thread from the object pools, let it
+ * exit and join it. The pools hold a single control block and stack, so
+ * every cycle must reuse them.
+ */
+static void BenchThreadCycle(void)
+{
+  static const osThreadAttr_t attr = {
+      .name       = NULL,
+      .attr_bits  = osThreadJoinable,
+      .priority   = osPriorityNormal,
+  };
+  osThreadId_t thread;
+  osThreadId_t thread_first = NULL;
+  void        *stack_first = NULL;
+  uint32_t     reuse = 1U;
+  uint32_t     start;
+  uint32_t     cycles;
+
+  start = DWT->CYCCNT;
+  for (uint32_t i = 0U; i < BENCH_LOOPS; i++) {
+    thread = osThreadNew(BenchExitThread, NULL, &attr);
+    if ((thread == NULL) || (osThreadJoin(thread) != osOK)) {
+      return;
+    }
+    if (i == 0U) {
+      thread_first = thread;
+      stack_first  = worker_ptr;
+    }
+    else if ((thread != thread_first) || (worker_ptr != stack_first)) {
+      reuse = 0U;
+    }
+  }
+  cycles = DWT->CYCCNT - start;
+
+  bench_thread_cycles = cycles / BENCH_LOOPS;
+  bench_thread_rate   = SystemCoreClock / bench_thread_cycles;
+  bench_thread_reuse  = reuse;
+}
+
+static void BenchTimerFunc(void *argument)
+{
+}
+
+/*
+ * Timing wheel insert: osTimerStart of one Timer with 10 to 10000 other
+ * Timers armed far in the future. The start ticks of the measured Timer are
+ * spread over all wheel levels, the cost must not depend on the number of
+ * armed Timers. Counts above BENCH_TIMER_NUM are skipped.
+ */
+static void BenchTimerInsert(void)
+{
+  static const uint32_t armed_num[4] = {10U, 100U, 1000U, 10000U};
+  osTimerAttr_t attr = {
+      .name      = NULL,
+      .attr_bits = 0U,
+      .cb_size   = sizeof(osTimer_t),
+  };
+  uint32_t      armed;
+  uint32_t      cycles;
+  uint32_t      start;
+
+  for (uint32_t i = 0U; i <= BENCH_TIMER_NUM; i++) {
+    attr.cb_mem = &bench_timer_cb[i];
+    bench_timer[i] = osTimerNew(BenchTimerFunc, osTimerOnce, NULL, &attr);
+    if (bench_timer[i] == NULL) {
+      return;
+    }
+  }
+
+  armed = 0U;
+  for (uint32_t n = 0U; n < 4U; n++) {
+    if (armed_num[n] > BENCH_TIMER_NUM) {
+      break;
+    }
+    for (; armed < armed_num[n]; armed++) {
+      osTimerStart(bench_timer[armed + 1U], 1000000U + armed);
+    }
+
+    cycles = 0U;
+    for (uint32_t i = 0U; i < BENCH_LOOPS; i++) {
+      start = DWT->CYCCNT;
+      osTimerStart(bench_timer[0], 100U + ((i * 997U) % 100000U));
+      cycles += DWT->CYCCNT - start;
+      osTimerStop(bench_timer[0]);
+    }
+    bench_timer_cycles[n] = cycles / BENCH_LOOPS;
+  }
+
+  for (uint32_t i = 0U; i <= BENCH_TIMER_NUM; i++) {
+    osTimerDelete(bench_timer[i]);
+  }
+}
+
+static void test_thread_func(void *param)
+{
+  test_failed = 0U;
+
+  for (uint32_t i = 0U; i < (sizeof(tests)/sizeof(tests[0])); i++) {
+    GPIOD->ODR ^= LED_BLUE;
+    if (!tests[i]()) {
+      test_failed = i + 1U;
+      break;
+    }
+  }
+
+  GPIOD->ODR &= ~LED_BLUE;
+  GPIOD->ODR |= (test_failed == 0U) ? LED_GREEN : LED_RED;
+
+  BenchThreadSwitch();
+  BenchMutexChain();
+  BenchThreadCycle();
+  BenchTimerInsert();
+}
+
+static void HardwareInit(void)
+{
+  RCC->AHB1ENR |= RCC_AHB1ENR_GPIODEN;
+  GPIOD->MODER |= (GPIO_MODER_MODER12_0 | GPIO_MODER_MODER13_0 | GPIO_MODER_MODER14_0 | GPIO_MODER_MODER15_0);
+
+  /* DWT cycle counter for the benchmarks */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*******************************************************************************
+ *  function implementations (scope: module-exported)
+ ******************************************************************************/
+
+int main(void)
+{
+  osStatus_t status;
+
+  HardwareInit();
+
+  status = osKernelInitialize();
+  if (status == osOK) {
+    test_thread = osThreadNew(test_thread_func, NULL, &test_thread_attr);
+    if (test_thread == NULL) {
+      goto error;
+    }
+
+    /* Start RTOS */
+    osKernelStart();
+  }
+
+error:
+  return (-1);
+}
+
+void osSysTickInit(uint32_t hz)
+{
+  SystemCoreClockUpdate();
+  SysTick_Config(SystemCoreClock/hz);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
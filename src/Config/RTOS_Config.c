@@ -19,6 +19,7 @@
  */
 
 #include "ukernel.h"
+#include "RTOS_Config.h"
 
 /* OS Idle Thread */
 __WEAK __NO_RETURN
@@ -27,7 +28,24 @@ void osIdleThread(void *argument)
   (void) argument;
 
   for (;;) {
-    ;
+#if (OS_TICKLESS_IDLE != 0)
+    uint32_t ticks;
+
+    ticks = osKernelSuspend();
+    if (ticks != 0U) {
+      /* An interrupt between osKernelSuspend and the sleep may have made a
+         Thread ready, check it with interrupts disabled and skip the sleep */
+      __disable_irq();
+      if (osKernelWakeupPending() == 0U) {
+        ticks = osSysTickSleep(ticks);
+      }
+      else {
+        ticks = 0U;
+      }
+      __enable_irq();
+    }
+    osKernelResume(ticks);
+#endif
   }
 }
 
@@ -38,4 +56,21 @@ void osSysTickInit(uint32_t hz)
   (void) hz;
 }
 
+/*
+ * Stop the tick, sleep for up to ticks and return the number of elapsed ticks.
+ * Called by the Idle Thread with interrupts disabled (PRIMASK set) once no
+ * Thread is ready, WFI still returns on a pending interrupt. Ticks counted by
+ * the tick interrupt must not be returned again.
+ * The default keeps the tick running and sleeps until the next interrupt.
+ */
+__WEAK
+uint32_t osSysTickSleep(uint32_t ticks)
+{
+  (void) ticks;
+
+  __WFI();
+
+  return (0U);
+}
+
 /* ----------------------------- End of file ---------------------------------*/
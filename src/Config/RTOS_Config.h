@@ -35,6 +35,7 @@
 
 //   <e>Round-Robin Thread switching
 //   <i> Enables Round-Robin Thread switching.
+//   <i> Threads created with osThreadAttr_t.time_slice are time sliced regardless of this setting.
 #ifndef OS_ROBIN_ENABLE
 #define OS_ROBIN_ENABLE             0
 #endif
@@ -48,6 +49,24 @@
 
 //   </e>
 
+//   <q>Tick-less Idle mode
+//   <i> Idle thread suspends the kernel tick until the nearest thread delay or timer expiry.
+//   <i> Requires osSysTickSleep to stop the tick source and return the number of elapsed ticks.
+//   <i> The default osSysTickSleep keeps the tick running and only waits for the next interrupt.
+#ifndef OS_TICKLESS_IDLE
+#define OS_TICKLESS_IDLE            0
+#endif
+
+//   <o>ISR post-processing queue size
+//     <0=> Disabled <4=> 4 entries <8=> 8 entries <12=> 12 entries <16=> 16 entries
+//     <24=> 24 entries <32=> 32 entries <48=> 48 entries <64=> 64 entries
+//   <i> Kernel functions called from interrupts only update the object and queue it,
+//   <i> waking of waiting threads is deferred to PendSV. Keeps ISR critical sections short.
+//   <i> Default: Disabled
+#ifndef OS_ISR_QUEUE_SIZE
+#define OS_ISR_QUEUE_SIZE           0
+#endif
+
 //   <o>Maximum priority of interrupts <1-255>
 //   <i> Defines the maximum priority of interrupts from which ISR safe API functions can be called.
 //   <i> Should be always greater than 0.
@@ -96,6 +115,13 @@
 #define OS_STACK_WATERMARK          0
 #endif
 
+//   <q>Thread runtime statistics
+//   <i> Accounts execution time and switch counts of each thread (see osThreadGetRuntime).
+//   <i> Uses the DWT cycle counter, or SysTick counter on cores without DWT (Cortex-M0/M0+).
+#ifndef OS_THREAD_RUNTIME
+#define OS_THREAD_RUNTIME           0
+#endif
+
 //   <o>Processor mode for Thread execution
 //     <0=> Unprivileged mode
 //     <1=> Privileged mode
@@ -104,6 +130,14 @@
 #define OS_PRIVILEGE_MODE           1
 #endif
 
+//   <q>Direct kernel calls
+//   <i> Privileged threads call kernel functions directly inside a critical section instead of through SVC.
+//   <i> Applies only to Privileged mode. Kernel functions then use the stack of the calling thread.
+//   <i> Kernel-aware interrupts stay masked for the whole kernel function, which adds to their latency.
+#ifndef OS_DIRECT_CALL
+#define OS_DIRECT_CALL              0
+#endif
+
 // </h>
 
 // <h>Timer Configuration
@@ -134,6 +168,225 @@
 
 // </h>
 
+// <h>Mutex Configuration
+// ======================
+
+//   <o>Priority inheritance chain depth <1-32>
+//   <i> Maximum number of owner threads a priority boost is propagated through
+//   <i> when the owner of a mutex is itself blocked on another mutex.
+//   <i> Bounds the time spent in osMutexAcquire.
+//   <i> Default: 4
+#ifndef OS_MUTEX_INHERIT_DEPTH
+#define OS_MUTEX_INHERIT_DEPTH      4
+#endif
+
+// </h>
+
+// <h>Object Memory Configuration
+// ===============================
+// <i> Objects created without user provided memory (attr == NULL or cb_mem == NULL)
+// <i> take their control blocks and data storage from fixed size kernel pools.
+// <i> Allocation and release are O(1) and do not fragment memory.
+
+//   <o>Number of Threads <0-1000>
+//   <i> Control blocks of threads created with cb_mem == NULL.
+//   <i> Default: 0
+#ifndef OS_THREAD_NUM
+#define OS_THREAD_NUM               0
+#endif
+
+//   <o>Number of Thread Stacks <0-1000>
+//   <i> Stacks of "Default Thread Stack size" for threads created with stack_mem == NULL.
+//   <i> Default: 0
+#ifndef OS_THREAD_STACK_NUM
+#define OS_THREAD_STACK_NUM         0
+#endif
+
+//   <o>Number of Timers <0-1000>
+//   <i> Default: 0
+#ifndef OS_TIMER_NUM
+#define OS_TIMER_NUM                0
+#endif
+
+//   <o>Number of Event Flags <0-1000>
+//   <i> Default: 0
+#ifndef OS_EVFLAGS_NUM
+#define OS_EVFLAGS_NUM              0
+#endif
+
+//   <o>Number of Mutexes <0-1000>
+//   <i> Default: 0
+#ifndef OS_MUTEX_NUM
+#define OS_MUTEX_NUM                0
+#endif
+
+//   <o>Number of Semaphores <0-1000>
+//   <i> Default: 0
+#ifndef OS_SEMAPHORE_NUM
+#define OS_SEMAPHORE_NUM            0
+#endif
+
+//   <o>Number of Memory Pools <0-1000>
+//   <i> Default: 0
+#ifndef OS_MEMPOOL_NUM
+#define OS_MEMPOOL_NUM              0
+#endif
+
+//   <o>Memory Pool data storage size [bytes] <0-1073741824:8>
+//   <i> Storage reserved for each Memory Pool created with mp_mem == NULL.
+//   <i> Default: 0
+#ifndef OS_MEMPOOL_DATA_SIZE
+#define OS_MEMPOOL_DATA_SIZE        0
+#endif
+
+//   <o>Number of Message Queues <0-1000>
+//   <i> Default: 0
+#ifndef OS_MSGQUEUE_NUM
+#define OS_MSGQUEUE_NUM             0
+#endif
+
+//   <o>Message Queue data storage size [bytes] <0-1073741824:8>
+//   <i> Storage reserved for each Message Queue created with mq_mem == NULL.
+//   <i> Default: 0
+#ifndef OS_MSGQUEUE_DATA_SIZE
+#define OS_MSGQUEUE_DATA_SIZE       0
+#endif
+
+//   <o>Number of Data Queues <0-1000>
+//   <i> Default: 0
+#ifndef OS_DATAQUEUE_NUM
+#define OS_DATAQUEUE_NUM            0
+#endif
+
+//   <o>Data Queue data storage size [bytes] <0-1073741824:8>
+//   <i> Storage reserved for each Data Queue created with dq_mem == NULL.
+//   <i> Default: 0
+#ifndef OS_DATAQUEUE_DATA_SIZE
+#define OS_DATAQUEUE_DATA_SIZE      0
+#endif
+
+//   <o>Number of Stream Buffers <0-1000>
+//   <i> Message Buffers share the Stream Buffer control block and data storage pools.
+//   <i> Default: 0
+#ifndef OS_STREAMBUF_NUM
+#define OS_STREAMBUF_NUM            0
+#endif
+
+//   <o>Stream Buffer data storage size [bytes] <0-1073741824:8>
+//   <i> Storage reserved for each Stream Buffer created with sb_mem == NULL.
+//   <i> Default: 0
+#ifndef OS_STREAMBUF_DATA_SIZE
+#define OS_STREAMBUF_DATA_SIZE      0
+#endif
+
+// </h>
+
+// <h>Memory Allocator Configuration
+// =================================
+// <i> osMemAlloc serves requests from the smallest size class that fits and has a free block.
+// <i> Each class is a fixed block Memory Pool: allocation and release are O(1).
+
+//   <o>Number of 16 byte blocks <0-65535>
+//   <i> Default: 0
+#ifndef OS_MEMALLOC_16_NUM
+#define OS_MEMALLOC_16_NUM          0
+#endif
+
+//   <o>Number of 32 byte blocks <0-65535>
+//   <i> Default: 0
+#ifndef OS_MEMALLOC_32_NUM
+#define OS_MEMALLOC_32_NUM          0
+#endif
+
+//   <o>Number of 64 byte blocks <0-65535>
+//   <i> Default: 0
+#ifndef OS_MEMALLOC_64_NUM
+#define OS_MEMALLOC_64_NUM          0
+#endif
+
+//   <o>Number of 128 byte blocks <0-65535>
+//   <i> Default: 0
+#ifndef OS_MEMALLOC_128_NUM
+#define OS_MEMALLOC_128_NUM         0
+#endif
+
+//   <o>Number of 256 byte blocks <0-65535>
+//   <i> Default: 0
+#ifndef OS_MEMALLOC_256_NUM
+#define OS_MEMALLOC_256_NUM         0
+#endif
+
+//   <o>Number of 512 byte blocks <0-65535>
+//   <i> Default: 0
+#ifndef OS_MEMALLOC_512_NUM
+#define OS_MEMALLOC_512_NUM         0
+#endif
+
+//   <o>Heap size [bytes] <0-67108864:8>
+//   <i> Storage of the TLSF heap used by osHeapAlloc for requests of arbitrary size.
+//   <i> Allocation and release take bounded time, each block costs 8 bytes of header.
+//   <i> Default: 0 (heap is not configured)
+#ifndef OS_HEAP_SIZE
+#define OS_HEAP_SIZE                0
+#endif
+
+// </h>
+
+// <e>Event Trace
+// ==============
+// <i> Records kernel events into a ring buffer (osTrace) for offline analysis.
+// <i> Timestamps use the DWT cycle counter, or SysTick counter on cores without DWT.
+// <i> Event classes that are not selected are removed at compile time.
+#ifndef OS_TRACE_ENABLE
+#define OS_TRACE_ENABLE             0
+#endif
+
+//   <o>Trace buffer size [records] <2-65536>
+//   <i> Number of 16 byte records in the ring buffer. Must be a power of 2.
+//   <i> Default: 256
+#ifndef OS_TRACE_BUFFER_SIZE
+#define OS_TRACE_BUFFER_SIZE        256
+#endif
+
+//   <q>Thread switches
+//   <i> Records each thread switch performed by PendSV.
+#ifndef OS_TRACE_SWITCH
+#define OS_TRACE_SWITCH             1
+#endif
+
+//   <q>Service calls
+//   <i> Records entry and exit of kernel functions called from threads.
+//   <i> The exit of a blocking call is recorded after the wakeup, so it includes the blocked time.
+#ifndef OS_TRACE_SVC
+#define OS_TRACE_SVC                0
+#endif
+
+//   <q>ISR calls
+//   <i> Records kernel functions called from interrupt handlers.
+#ifndef OS_TRACE_ISR
+#define OS_TRACE_ISR                1
+#endif
+
+//   <q>Thread waits
+//   <i> Records threads entering the wait state.
+#ifndef OS_TRACE_WAIT
+#define OS_TRACE_WAIT               1
+#endif
+
+//   <q>Thread wakeups
+//   <i> Records threads leaving the wait state.
+#ifndef OS_TRACE_WAKEUP
+#define OS_TRACE_WAKEUP             1
+#endif
+
+//   <q>Timeouts
+//   <i> Records expired thread delays and timers.
+#ifndef OS_TRACE_TIMEOUT
+#define OS_TRACE_TIMEOUT            1
+#endif
+
+// </e>
+
 //------------- <<< end of configuration section >>> ---------------------------
 
 #endif  /* _RTOS_CONFIG_H_ */
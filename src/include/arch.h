@@ -46,6 +46,35 @@
 #define PENDSVSET           (0x10000000U)
 #define FILL_STACK_VALUE    (0xFFFFFFFFU)
 
+/* Floating-point Context Control Register */
+#define FPCCR               (*(__IOM uint32_t *)0xE000EF34UL)
+#define FPCCR_ASPEN         (1UL << 31)             /*!< Automatic state preservation enable */
+#define FPCCR_LSPEN         (1UL << 30)             /*!< Lazy state preservation enable */
+
+/* Hardware FPU is used by the compiler (irq_cm4f port is required) */
+#if (defined(__ARM_FP) || defined(__TARGET_FPU_VFP) || defined(__ARMVFP__))
+  #define ARCH_FPU_USED     (1U)
+#else
+  #define ARCH_FPU_USED     (0U)
+#endif
+
+/* SysTick pending bit in the Interrupt Control State Register */
+#define PENDSTSET           (0x04000000U)
+
+/* SysTick Reload Value and Current Value Registers */
+#define SYST_RVR            (*(__IOM uint32_t *)0xE000E014UL)
+#define SYST_CVR            (*(__IOM uint32_t *)0xE000E018UL)
+
+/* DWT Cycle Counter (ARMv7-M and ARMv8-M Mainline) */
+#define DEMCR               (*(__IOM uint32_t *)0xE000EDFCUL)
+#define DEMCR_TRCENA        (1UL << 24)             /*!< Enable DWT and ITM */
+#define DWT_CTRL            (*(__IOM uint32_t *)0xE0001000UL)
+#define DWT_CTRL_CYCCNTENA  (1UL << 0)              /*!< Enable Cycle Counter */
+#define DWT_CYCCNT          (*(__IOM uint32_t *)0xE0001004UL)
+
+/* Initial EXC_RETURN value: Thread mode, PSP, basic stack frame */
+#define INITIAL_EXC_RETURN  (0xFFFFFFFDU)
+
 #if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) ||       \
        (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) ||       \
        (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)))
@@ -208,6 +237,10 @@ uint32_t SystemIsrInit(void)
     n = p + 1U;
   }
   SCB->SHP[7] = (uint8_t)(0xFEU << n);
+#if (ARCH_FPU_USED != 0U)
+  /* FP context is stacked lazily and only by threads that used the FPU */
+  FPCCR |= (FPCCR_ASPEN | FPCCR_LSPEN);
+#endif
   return (n);
 #elif ((defined(__ARM_ARCH_6M__)      && (__ARM_ARCH_6M__      != 0)) || \
        (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
@@ -228,6 +261,220 @@ void archSwitchContextRequest(void)
   SCB->ICSR = PENDSVSET;
 }
 
+/*
+ * Atomic access operations. Exclusive access instructions are used on cores
+ * that provide them, other cores disable interrupts for the few instructions
+ * of the read-modify-write sequence.
+ */
+
+#if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) ||       \
+       (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) ||       \
+       (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)))
+#define ARCH_EXCLUSIVE_ACCESS         1U
+#else
+#define ARCH_EXCLUSIVE_ACCESS         0U
+#endif
+
+/**
+ * @fn          uint32_t archAtomicSetBits(volatile uint32_t *mem, uint32_t bits)
+ * @brief       Atomically set bits of a 32-bit value.
+ * @param[out]  mem   pointer to the value.
+ * @param[in]   bits  bits to set.
+ * @return      new value.
+ */
+__STATIC_INLINE
+uint32_t archAtomicSetBits(volatile uint32_t *mem, uint32_t bits)
+{
+  uint32_t val;
+
+#if (ARCH_EXCLUSIVE_ACCESS != 0U)
+  do {
+    val = __LDREXW(mem) | bits;
+  } while (__STREXW(val, mem) != 0U);
+#else
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  val = *mem | bits;
+  *mem = val;
+  __set_PRIMASK(primask);
+#endif
+
+  return (val);
+}
+
+/**
+ * @fn          uint32_t archAtomicIncLimit(volatile uint32_t *mem, uint32_t limit)
+ * @brief       Atomically increment a 32-bit value if it is below a limit.
+ * @param[out]  mem     pointer to the value.
+ * @param[in]   limit   limit value.
+ * @return      previous value (the value was not changed if it is equal to limit).
+ */
+__STATIC_INLINE
+uint32_t archAtomicIncLimit(volatile uint32_t *mem, uint32_t limit)
+{
+  uint32_t val;
+
+#if (ARCH_EXCLUSIVE_ACCESS != 0U)
+  do {
+    val = __LDREXW(mem);
+    if (val >= limit) {
+      __CLREX();
+      break;
+    }
+  } while (__STREXW(val + 1U, mem) != 0U);
+#else
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  val = *mem;
+  if (val < limit) {
+    *mem = val + 1U;
+  }
+  __set_PRIMASK(primask);
+#endif
+
+  return (val);
+}
+
+/**
+ * @fn          uint16_t archAtomicIncLimit16(volatile uint16_t *mem, uint16_t limit)
+ * @brief       Atomically increment a 16-bit value if it is below a limit.
+ * @param[out]  mem     pointer to the value.
+ * @param[in]   limit   limit value.
+ * @return      previous value (the value was not changed if it is equal to limit).
+ */
+__STATIC_INLINE
+uint16_t archAtomicIncLimit16(volatile uint16_t *mem, uint16_t limit)
+{
+  uint16_t val;
+
+#if (ARCH_EXCLUSIVE_ACCESS != 0U)
+  do {
+    val = __LDREXH(mem);
+    if (val >= limit) {
+      __CLREX();
+      break;
+    }
+  } while (__STREXH((uint16_t)(val + 1U), mem) != 0U);
+#else
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  val = *mem;
+  if (val < limit) {
+    *mem = (uint16_t)(val + 1U);
+  }
+  __set_PRIMASK(primask);
+#endif
+
+  return (val);
+}
+
+/**
+ * @fn          uint32_t archAtomicIncWrap(volatile uint32_t *mem, uint32_t size)
+ * @brief       Atomically increment a ring buffer index.
+ * @param[out]  mem   pointer to the index.
+ * @param[in]   size  ring buffer size (the index wraps to 0 when it reaches size).
+ * @return      previous index.
+ */
+__STATIC_INLINE
+uint32_t archAtomicIncWrap(volatile uint32_t *mem, uint32_t size)
+{
+  uint32_t val;
+  uint32_t next;
+
+#if (ARCH_EXCLUSIVE_ACCESS != 0U)
+  do {
+    val  = __LDREXW(mem);
+    next = val + 1U;
+    if (next == size) {
+      next = 0U;
+    }
+  } while (__STREXW(next, mem) != 0U);
+#else
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  val  = *mem;
+  next = val + 1U;
+  if (next == size) {
+    next = 0U;
+  }
+  *mem = next;
+  __set_PRIMASK(primask);
+#endif
+
+  return (val);
+}
+
+/**
+ * @fn          void archAtomicDec(volatile uint32_t *mem)
+ * @brief       Atomically decrement a 32-bit value.
+ * @param[out]  mem   pointer to the value.
+ */
+__STATIC_INLINE
+void archAtomicDec(volatile uint32_t *mem)
+{
+#if (ARCH_EXCLUSIVE_ACCESS != 0U)
+  uint32_t val;
+
+  do {
+    val = __LDREXW(mem) - 1U;
+  } while (__STREXW(val, mem) != 0U);
+#else
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  *mem = *mem - 1U;
+  __set_PRIMASK(primask);
+#endif
+}
+
+/**
+ * @fn          void archCycleCounterInit(void)
+ * @brief       Start the cycle counter used for runtime accounting.
+ */
+__STATIC_INLINE
+void archCycleCounterInit(void)
+{
+#if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) ||       \
+       (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) ||       \
+       (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)))
+  DEMCR    |= DEMCR_TRCENA;
+  DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif
+}
+
+/**
+ * @fn          uint32_t archCycleCounterGet(uint32_t tick)
+ * @brief       Get the cycle counter used for runtime accounting.
+ * @param[in]   tick  kernel tick count (used when there is no DWT cycle counter).
+ * @return      DWT cycle counter, or SysTick based counter on cores without DWT.
+ */
+__STATIC_INLINE
+uint32_t archCycleCounterGet(uint32_t tick)
+{
+#if   ((defined(__ARM_ARCH_7M__)      && (__ARM_ARCH_7M__      != 0)) ||       \
+       (defined(__ARM_ARCH_7EM__)     && (__ARM_ARCH_7EM__     != 0)) ||       \
+       (defined(__ARM_ARCH_8M_MAIN__) && (__ARM_ARCH_8M_MAIN__ != 0)))
+  (void)tick;
+
+  return (DWT_CYCCNT);
+#else
+  uint32_t load = SYST_RVR;
+  uint32_t val  = SYST_CVR;
+
+  /* SysTick wrapped but the tick is not processed yet */
+  if ((SCB->ICSR & PENDSTSET) != 0U) {
+    val = SYST_CVR;
+    tick++;
+  }
+
+  return ((tick * (load + 1U)) + (load - val));
+#endif
+}
+
 __STATIC_FORCEINLINE
 uint32_t svc_0(uint32_t func)
 {
@@ -26,6 +26,7 @@
 
 #include "arch.h"
 #include "ukernel.h"
+#include "RTOS_Config.h"
 
 /*******************************************************************************
  *  defines and macros (scope: module-local)
@@ -47,6 +48,8 @@
 #define ID_MESSAGE_QUEUE            0x1C
 #define ID_MESSAGE                  0x1D
 #define ID_DATA_QUEUE               0x1E
+#define ID_STREAM_BUFFER            0x1F
+#define ID_MESSAGE_BUFFER           0x20
 
 /* Thread State definitions */
 #define ThreadStateInactive         ((uint8_t)osThreadInactive)
@@ -55,21 +58,85 @@
 #define ThreadStateBlocked          ((uint8_t)osThreadBlocked)
 #define ThreadStateTerminated       ((uint8_t)osThreadTerminated)
 
+/* Object Flags definitions */
+#define osFlagSystemObject          0x01U       ///< Control Block allocated from an Object Memory Pool
+#define osFlagSystemMemory          0x02U       ///< Data Storage (Stack) allocated from an Object Memory Pool
+
+/* Object Memory Pool definitions */
+#define osObjectPoolStack           0U          ///< Thread Stacks (default stack size)
+#define osObjectPoolThread          1U          ///< Thread Control Blocks
+#define osObjectPoolTimer           2U          ///< Timer Control Blocks
+#define osObjectPoolEventFlags      3U          ///< Event Flags Control Blocks
+#define osObjectPoolMutex           4U          ///< Mutex Control Blocks
+#define osObjectPoolSemaphore       5U          ///< Semaphore Control Blocks
+#define osObjectPoolMemoryPool      6U          ///< Memory Pool Control Blocks
+#define osObjectPoolMemoryPoolData  7U          ///< Memory Pool Data Storage
+#define osObjectPoolMessageQueue    8U          ///< Message Queue Control Blocks
+#define osObjectPoolMsgQueueData    9U          ///< Message Queue Data Storage
+#define osObjectPoolDataQueue       10U         ///< Data Queue Control Blocks
+#define osObjectPoolDataQueueData   11U         ///< Data Queue Data Storage
+#define osObjectPoolStreamBuffer    12U         ///< Stream Buffer Control Blocks
+#define osObjectPoolStreamBufData   13U         ///< Stream Buffer Data Storage
+#define osObjectPoolNum             14U         ///< Number of Object Memory Pools
+
 #define container_of(ptr, type, member) ((type *)((uint8_t *)(ptr) - offsetof(type, member)))
 
 #define GetThreadByQueue(que)       container_of(que, osThread_t, thread_que)
-#define GetThreadByDelayQueue(que)  container_of(que, osThread_t, delay_que)
+#define GetThreadByFlagsQueue(que)  container_of(que, osThread_t, flags_que)
 #define GetMutexByQueque(que)       container_of(que, osMutex_t, mutex_que)
-#define GetTimerByQueue(que)        container_of(que, osTimer_t, timer_que)
+#define GetTimeoutByQueue(entry)    container_of(entry, timeout_t, que)
+#define GetThreadByTimeout(tmo)     container_of(tmo, osThread_t, delay)
+#define GetTimerByTimeout(tmo)      container_of(tmo, osTimer_t, timeout)
 #define GetMessageByQueue(que)      container_of(que, osMessage_t, msg_que)
 
 #define NUM_PRIORITY                (32U)
+
+/* Timing Wheel definitions */
+#define WHEEL_BITS                  (4U)                      ///< Slot index bits per level
+#define WHEEL_SIZE                  (1UL << WHEEL_BITS)       ///< Number of slots per level
+#define WHEEL_MASK                  (WHEEL_SIZE - 1U)
+#define WHEEL_LEVELS                (32U / WHEEL_BITS)        ///< Number of levels to cover 32-bit time
 #define osThreadWait                (-16)
 
 /* OS Configuration flags */
 #define osConfigPrivilegedMode      (1UL<<0)    ///< Threads in Privileged mode
 #define osConfigStackCheck          (1UL<<1)    ///< Stack overrun checking
 #define osConfigStackWatermark      (1UL<<2)    ///< Stack usage Watermark
+#define osConfigDirectCall          (1UL<<3)    ///< Direct kernel calls from Threads
+#define osConfigThreadRuntime       (1UL<<4)    ///< Thread runtime statistics
+
+/* Trace Event Class definitions */
+#define osTraceClassSwitch          (1UL<<0)    ///< Thread switches
+#define osTraceClassSvc             (1UL<<1)    ///< Service calls
+#define osTraceClassIsr             (1UL<<2)    ///< ISR calls
+#define osTraceClassWait            (1UL<<3)    ///< Thread waits
+#define osTraceClassWakeup          (1UL<<4)    ///< Thread wakeups
+#define osTraceClassTimeout         (1UL<<5)    ///< Timeouts
+
+/* Trace Event definitions (bits 7..4 select the event class) */
+#define osTraceThreadSwitch         0x00U       ///< arg1: current thread, arg2: next thread
+#define osTraceSvcEnter             0x10U       ///< arg1: function, arg2: first parameter
+#define osTraceSvcExit              0x11U       ///< arg1: function, arg2: return value (after the wakeup of a blocking call)
+#define osTraceIsrCall              0x20U       ///< arg1: function, arg2: object
+#define osTraceThreadWait           0x30U       ///< arg1: thread, arg2: timeout
+#define osTraceThreadWakeup         0x40U       ///< arg1: thread, arg2: return value
+#define osTraceThreadTimeout        0x50U       ///< arg1: thread, arg2: kernel tick
+#define osTraceTimerExpire          0x51U       ///< arg1: timer, arg2: kernel tick
+
+#define osTraceMagic                0x52544B75U ///< Trace buffer signature ("uKTR")
+
+/* Event classes compiled into the kernel */
+#if (OS_TRACE_ENABLE != 0)
+#define osTraceFilter               (0U                                               \
+                                     | ((OS_TRACE_SWITCH  != 0) ? osTraceClassSwitch  : 0U) \
+                                     | ((OS_TRACE_SVC     != 0) ? osTraceClassSvc     : 0U) \
+                                     | ((OS_TRACE_ISR     != 0) ? osTraceClassIsr     : 0U) \
+                                     | ((OS_TRACE_WAIT    != 0) ? osTraceClassWait    : 0U) \
+                                     | ((OS_TRACE_WAKEUP  != 0) ? osTraceClassWakeup  : 0U) \
+                                     | ((OS_TRACE_TIMEOUT != 0) ? osTraceClassTimeout : 0U))
+#else
+#define osTraceFilter               (0U)
+#endif
 
 /*******************************************************************************
  *  typedefs and structures (scope: module-local)
@@ -92,16 +159,98 @@ typedef struct osInfo_s {
   uint32_t                       base_priority;
   uint32_t                    ready_to_run_bmp;
   queue_t             ready_list[NUM_PRIORITY];   ///< all ready to run(RUNNABLE) tasks
-  queue_t                          timer_queue;
-  queue_t                          delay_queue;
+  struct {
+    uint32_t                              tick;   ///< Next tick to be processed
+    uint32_t                 bmp[WHEEL_LEVELS];   ///< Non-empty slots bitmap
+    queue_t      slot[WHEEL_LEVELS][WHEEL_SIZE];   ///< Timing wheel slots
+  } wheel;
+  queue_t                          timer_queue;   ///< Expired timers
   osSemaphoreId_t              timer_semaphore;
+  struct {
+    uint32_t                             stamp;   ///< Cycle counter at the last accounting
+    uint64_t                             total;   ///< Cycles accounted since the kernel start
+  } runtime;
+  struct {
+    uint32_t                               cnt;   ///< Number of queued requests
+    uint32_t                                in;   ///< Write index
+    uint32_t                               out;   ///< Read index
+  } isr_queue;                                    ///< ISR post-processing queue
 } osInfo_t;
 
+/* ISR Post-processing Request structure */
+typedef struct osIsrRequest_s {
+  void                        (*func)(void *);   ///< Post-processing function
+  void                                 *object;   ///< Object to process
+} osIsrRequest_t;
+
+/* Object Memory Pool Configuration structure */
+typedef struct osObjectPool_s {
+  osMemoryPoolInfo_t                   *info;   ///< Memory Pool information (NULL - pool is not configured)
+  void                                  *mem;   ///< Memory for block storage
+  uint32_t                             count;   ///< Number of blocks
+  uint32_t                              size;   ///< Block size in bytes
+} osObjectPool_t;
+
+/* Memory Allocator size class */
+typedef struct osMemClass_s {
+  wait_queue_t                    wait_queue;   ///< Threads waiting for a block of this class
+  osMemoryPoolInfo_t                    info;   ///< Memory Pool information
+  uint32_t                          max_used;   ///< Maximum number of used blocks
+  uint32_t                        fail_count;   ///< Number of requests not served immediately
+} osMemClass_t;
+
+/* Heap TLSF index: 8 second level lists per power of 2, blocks below 64 MB */
+#define osHeapSlCount               8U
+#define osHeapFlCount               21U
+
+/* Heap Block header, the free list links overlay the payload of a free block */
+typedef struct osHeapBlock_s {
+  struct osHeapBlock_s         *prev_phys;   ///< Previous block in memory (NULL - first block)
+  uint32_t                           size;   ///< Payload size in bytes, bit 0 - block is free
+  struct osHeapBlock_s         *next_free;   ///< Next block in the free list
+  struct osHeapBlock_s         *prev_free;   ///< Previous block in the free list
+} osHeapBlock_t;
+
+/* Heap Control Block */
+typedef struct osHeap_s {
+  wait_queue_t                    wait_queue;   ///< Threads waiting for memory
+  uint32_t                         fl_bitmap;   ///< First level lists that are not empty
+  uint32_t          sl_bitmap[osHeapFlCount];   ///< Second level lists that are not empty
+  osHeapBlock_t *blocks[osHeapFlCount][osHeapSlCount];   ///< Free lists
+  osHeapBlock_t                        *base;   ///< First block
+  osHeapBlock_t                       *limit;   ///< Sentinel block at the end of the heap
+  uint32_t                              size;   ///< Payload size of the heap in bytes
+  uint32_t                         free_size;   ///< Free space in bytes
+  uint32_t                     min_free_size;   ///< Minimum free space in bytes
+  uint32_t                       used_blocks;   ///< Number of allocated blocks
+  uint32_t                       free_blocks;   ///< Number of free blocks
+  uint32_t                        fail_count;   ///< Number of requests not served immediately
+} osHeap_t;
+
+/* Trace Record structure (16 bytes) */
+typedef struct osTraceRecord_s {
+  uint32_t                              time;   ///< Cycle counter
+  uint16_t                             event;   ///< Event identifier
+  uint16_t                              ipsr;   ///< Active exception number (0 - Thread mode)
+  uint32_t                              arg1;   ///< First event argument
+  uint32_t                              arg2;   ///< Second event argument
+} osTraceRecord_t;
+
+/* Trace Buffer structure */
+typedef struct osTrace_s {
+  uint32_t                             magic;   ///< osTraceMagic
+  uint32_t                              size;   ///< Number of records in the ring buffer
+  uint32_t                              head;   ///< Number of records written since the kernel initialization
+  uint32_t                            filter;   ///< Event classes compiled into the kernel
+  osTraceRecord_t record[OS_TRACE_BUFFER_SIZE];   ///< Ring buffer
+} osTrace_t;
+
 /* OS Configuration structure */
 typedef struct osConfig_s {
   uint32_t                             flags;   ///< OS Configuration Flags
   uint32_t                         tick_freq;   ///< Kernel Tick Frequency
   uint32_t                     robin_timeout;   ///< Round Robin Timeout Tick
+  uint32_t                     inherit_depth;   ///< Priority inheritance chain depth
   uint32_t        max_api_interrupt_priority;
   const
   osThreadAttr_t           *idle_thread_attr;   ///< Idle Thread Attributes
@@ -109,6 +258,18 @@ typedef struct osConfig_s {
   osThreadAttr_t          *timer_thread_attr;   ///< Timer Thread Attributes
   const
   osSemaphoreAttr_t    *timer_semaphore_attr;   ///< Timer Semaphore Attributes
+  struct {
+    osIsrRequest_t                       *data;   ///< Queue storage
+    uint32_t                               max;   ///< Maximum number of requests (0 - disabled)
+  } isr_queue;                                    ///< ISR post-processing queue
+  osObjectPool_t            mpi[osObjectPoolNum];   ///< Object Memory Pools
+  osMemClass_t                        *mem_class;   ///< Memory Allocator size classes (NULL - not configured)
+  osObjectPool_t         mem_pool[osMemClassNum];   ///< Memory Allocator block storage
+  struct {
+    osHeap_t                               *cb;   ///< Heap control block (NULL - heap is not configured)
+    void                                  *mem;   ///< Heap storage
+    uint32_t                              size;   ///< Heap storage size in bytes
+  } heap;                                         ///< Kernel Heap
 } osConfig_t;
 
 typedef enum {
@@ -122,11 +283,244 @@ typedef enum {
 
 extern osInfo_t osInfo;                   ///< OS Runtime Information
 extern const osConfig_t osConfig;         ///< OS Configuration
+#if (OS_TRACE_ENABLE != 0)
+extern osTrace_t osTrace;                 ///< Trace Buffer
+#endif
 
 /*******************************************************************************
  *  exported function prototypes
  ******************************************************************************/
 
+/* Trace */
+
+/**
+ * @brief       Initialize the Trace Buffer.
+ */
+void libTraceInit(void);
+
+/**
+ * @brief       Write an event record into the Trace Buffer.
+ * @param[in]   event   event identifier.
+ * @param[in]   arg1    first event argument.
+ * @param[in]   arg2    second event argument.
+ */
+void libTraceRecord(uint32_t event, uint32_t arg1, uint32_t arg2);
+
+/**
+ * @fn          void TraceEvent(uint32_t event, uint32_t arg1, uint32_t arg2)
+ * @brief       Record an event if its class is compiled into the kernel.
+ * @param[in]   event   event identifier.
+ * @param[in]   arg1    first event argument.
+ * @param[in]   arg2    second event argument.
+ */
+__STATIC_FORCEINLINE
+void TraceEvent(uint32_t event, uint32_t arg1, uint32_t arg2)
+{
+  if ((osTraceFilter & (1UL << (event >> 4))) != 0U) {
+    libTraceRecord(event, arg1, arg2);
+  }
+}
+
+
+/* Service Calls */
+
+/*
+ * When Threads run in privileged mode with osConfigDirectCall set, kernel
+ * functions are executed directly in the caller context inside a critical
+ * section instead of through the SVC exception. A thread switch requested
+ * by the function is performed by PendSV as soon as the critical section
+ * is left. Calls that must execute in Handler mode use the original svc_N
+ * functions by enclosing the name in parentheses, e.g. (svc_0)(func).
+ *
+ * The critical section masks the kernel-aware interrupts for the whole
+ * kernel function, while the SVC handler can be preempted by them. Direct
+ * calls therefore trade a shorter call path for a longer interrupt latency,
+ * bounded by the longest kernel function. Read-only queries of a single
+ * kernel variable (svc_read_N) run without the critical section.
+ *
+ * Before osKernelStart the critical section does not mask interrupts
+ * (base_priority is not set yet), so calls go through SVC until the
+ * kernel is running.
+ */
+
+__STATIC_FORCEINLINE
+bool IsDirectCall(void)
+{
+  return ((((osConfig.flags & osConfigDirectCall) != 0U) &&
+           (osInfo.kernel.state >= osKernelRunning)) ? true : false);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_direct_0(uint32_t func)
+{
+  uint32_t ret;
+
+  TraceEvent(osTraceSvcEnter, func, 0U);
+
+  if (!IsDirectCall()) {
+    ret = svc_0(func);
+  }
+  else {
+    BEGIN_CRITICAL_SECTION
+    ret = ((uint32_t (*)(void))func)();
+    END_CRITICAL_SECTION
+    __ISB();
+  }
+
+  TraceEvent(osTraceSvcExit, func, ret);
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_direct_1(uint32_t param1, uint32_t func)
+{
+  uint32_t ret;
+
+  TraceEvent(osTraceSvcEnter, func, param1);
+
+  if (!IsDirectCall()) {
+    ret = svc_1(param1, func);
+  }
+  else {
+    BEGIN_CRITICAL_SECTION
+    ret = ((uint32_t (*)(uint32_t))func)(param1);
+    END_CRITICAL_SECTION
+    __ISB();
+  }
+
+  TraceEvent(osTraceSvcExit, func, ret);
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_direct_2(uint32_t param1, uint32_t param2, uint32_t func)
+{
+  uint32_t ret;
+
+  TraceEvent(osTraceSvcEnter, func, param1);
+
+  if (!IsDirectCall()) {
+    ret = svc_2(param1, param2, func);
+  }
+  else {
+    BEGIN_CRITICAL_SECTION
+    ret = ((uint32_t (*)(uint32_t, uint32_t))func)(param1, param2);
+    END_CRITICAL_SECTION
+    __ISB();
+  }
+
+  TraceEvent(osTraceSvcExit, func, ret);
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_direct_3(uint32_t param1, uint32_t param2, uint32_t param3, uint32_t func)
+{
+  uint32_t ret;
+
+  TraceEvent(osTraceSvcEnter, func, param1);
+
+  if (!IsDirectCall()) {
+    ret = svc_3(param1, param2, param3, func);
+  }
+  else {
+    BEGIN_CRITICAL_SECTION
+    ret = ((uint32_t (*)(uint32_t, uint32_t, uint32_t))func)(param1, param2, param3);
+    END_CRITICAL_SECTION
+    __ISB();
+  }
+
+  TraceEvent(osTraceSvcExit, func, ret);
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_direct_4(uint32_t param1, uint32_t param2, uint32_t param3, uint32_t param4, uint32_t func)
+{
+  uint32_t ret;
+
+  TraceEvent(osTraceSvcEnter, func, param1);
+
+  if (!IsDirectCall()) {
+    ret = svc_4(param1, param2, param3, param4, func);
+  }
+  else {
+    BEGIN_CRITICAL_SECTION
+    ret = ((uint32_t (*)(uint32_t, uint32_t, uint32_t, uint32_t))func)(param1, param2, param3, param4);
+    END_CRITICAL_SECTION
+    __ISB();
+  }
+
+  TraceEvent(osTraceSvcExit, func, ret);
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_read_0(uint32_t func)
+{
+  uint32_t ret;
+
+  if (!IsDirectCall()) {
+    ret = svc_direct_0(func);
+  }
+  else {
+    ret = ((uint32_t (*)(void))func)();
+  }
+
+  return (ret);
+}
+
+__STATIC_FORCEINLINE
+uint32_t svc_read_1(uint32_t param1, uint32_t func)
+{
+  uint32_t ret;
+
+  if (!IsDirectCall()) {
+    ret = svc_direct_1(param1, func);
+  }
+  else {
+    ret = ((uint32_t (*)(uint32_t))func)(param1);
+  }
+
+  return (ret);
+}
+
+#define svc_0(func)                       svc_direct_0(func)
+#define svc_1(p1, func)                   svc_direct_1(p1, func)
+#define svc_2(p1, p2, func)               svc_direct_2(p1, p2, func)
+#define svc_3(p1, p2, p3, func)           svc_direct_3(p1, p2, p3, func)
+#define svc_4(p1, p2, p3, p4, func)       svc_direct_4(p1, p2, p3, p4, func)
+
+/* ISR Post-processing */
+
+/**
+ * @fn          bool IsIrqDeferred(void)
+ * @brief       Check if waking of threads by kernel functions called from ISR is deferred.
+ * @return      true - deferred to PendSV, false - performed in the ISR.
+ */
+__STATIC_FORCEINLINE
+bool IsIrqDeferred(void)
+{
+  return ((osConfig.isr_queue.max != 0U) ? true : false);
+}
+
+/**
+ * @brief       Queue an object for post-processing by PendSV (called from ISR).
+ * @param[in]   func    post-processing function.
+ * @param[in]   object  object to process.
+ */
+void libIsrQueuePut(void (*func)(void *), void *object);
+
+/**
+ * @brief       Process the objects queued by ISRs (executed by PendSV).
+ */
+void libIsrQueueProcess(void);
+
 /* Thread */
 
 /**
@@ -142,24 +536,41 @@ bool libThreadStartup(void);
  */
 void libThreadWaitExit(osThread_t *thread, uint32_t ret_val, dispatch_t dispatch);
 
+/**
+ * @brief       Exit Thread wait state on timeout or resume without being served.
+ * @param[out]  thread    thread object.
+ * @param[in]   dispatch  dispatch the highest priority Ready Thread.
+ */
+void libThreadWaitTimeout(osThread_t *thread, dispatch_t dispatch);
+
 /**
  * @brief       Enter Thread wait state.
  * @param[out]  thread    thread object.
  * @param[out]  wait_que  Pointer to wait queue.
  * @param[in]   timeout   Timeout
  */
-bool libThreadWaitEnter(osThread_t *thread, queue_t *wait_que, uint32_t timeout);
+bool libThreadWaitEnter(osThread_t *thread, wait_queue_t *wait_que, uint32_t timeout);
 
 /**
- * @brief
- * @param wait_que
+ * @brief       Release all Threads waiting in the wait queue.
+ * @param[out]  wait_que  Pointer to wait queue.
+ */
+void libThreadWaitDelete(wait_queue_t *wait_que);
+
+/**
+ * @brief       Process Round-Robin Time Slice of the running Thread (executed each System Tick).
+ */
+void libThreadRobinTick(void);
+
+/**
+ * @brief       Account the time elapsed since the last accounting to the running Thread.
  */
-void libThreadWaitDelete(queue_t *que);
+void libThreadRuntimeUpdate(void);
 
 /**
- * @brief       Process Thread Delay Tick (executed each System Tick).
+ * @brief       Account the Thread switch in runtime statistics and trace (executed by PendSV before the switch).
  */
-bool libThreadDelayTick(void);
+void libThreadRuntimeSwitch(void);
 
 /**
  * @brief       Change priority of a thread.
@@ -232,6 +643,24 @@ queue_t* QueueExtract(queue_t *que)
   return (entry);
 }
 
+/**
+ * @fn          void QueueMove(queue_t *que, queue_t *src)
+ * @brief       Moves all entries of a queue to the tail of another queue.
+ * @param[out]  que   Pointer to the destination queue
+ * @param[out]  src   Pointer to the source queue
+ */
+__STATIC_FORCEINLINE
+void QueueMove(queue_t *que, queue_t *src)
+{
+  if (!isQueueEmpty(src)) {
+    src->next->prev = que->prev;
+    que->prev->next = src->next;
+    src->prev->next = que;
+    que->prev = src->prev;
+    QueueReset(src);
+  }
+}
+
 /**
  * @fn          void QueueRemoveEntry(queue_t *entry)
  * @brief       Removes an entry from the queue.
@@ -248,6 +677,119 @@ void QueueRemoveEntry(queue_t *entry)
 }
 
 
+/* Wait Queue */
+
+/**
+ * @fn          void WaitQueueReset(wait_queue_t *wait_que)
+ * @brief       Initializes an empty wait queue.
+ * @param[out]  wait_que  Pointer to the wait queue
+ */
+__STATIC_FORCEINLINE
+void WaitQueueReset(wait_queue_t *wait_que)
+{
+  wait_que->bmp = 0U;
+  for (uint32_t i = 0U; i < NUM_PRIORITY; i++) {
+    QueueReset(&wait_que->list[i]);
+  }
+}
+
+__STATIC_FORCEINLINE
+bool isWaitQueueEmpty(wait_queue_t *wait_que)
+{
+  return ((wait_que->bmp == 0U) ? true : false);
+}
+
+/**
+ * @fn          osThread_t* WaitQueueHead(wait_queue_t *wait_que)
+ * @brief       Returns the first waiting thread with the highest priority.
+ * @param[in]   wait_que  Pointer to the wait queue
+ * @return      Pointer to the thread or NULL if the wait queue is empty
+ */
+__STATIC_FORCEINLINE
+osThread_t* WaitQueueHead(wait_queue_t *wait_que)
+{
+  uint32_t priority;
+
+  if (wait_que->bmp == 0U) {
+    return (NULL);
+  }
+
+  priority = (NUM_PRIORITY - 1U) - __CLZ(wait_que->bmp);
+
+  return (GetThreadByQueue(wait_que->list[priority].next));
+}
+
+/**
+ * @fn          osThread_t* WaitQueueNext(wait_queue_t *wait_que, osThread_t *thread)
+ * @brief       Returns the waiting thread that follows the specified one.
+ * @param[in]   wait_que  Pointer to the wait queue
+ * @param[in]   thread    Pointer to the thread included in the wait queue
+ * @return      Pointer to the thread or NULL if it is the last one
+ */
+__STATIC_FORCEINLINE
+osThread_t* WaitQueueNext(wait_queue_t *wait_que, osThread_t *thread)
+{
+  uint32_t priority = (uint32_t)thread->priority - 1U;
+  uint32_t bmp;
+
+  if (thread->thread_que.next != &wait_que->list[priority]) {
+    return (GetThreadByQueue(thread->thread_que.next));
+  }
+
+  /* Continue with the lower priority lists */
+  bmp = wait_que->bmp & ((1UL << priority) - 1U);
+  if (bmp == 0U) {
+    return (NULL);
+  }
+
+  priority = (NUM_PRIORITY - 1U) - __CLZ(bmp);
+
+  return (GetThreadByQueue(wait_que->list[priority].next));
+}
+
+
+/* Timeout */
+
+__STATIC_FORCEINLINE
+void TimeoutReset(timeout_t *timeout, uint8_t owner)
+{
+  QueueReset(&timeout->que);
+  timeout->time  = 0U;
+  timeout->owner = owner;
+  timeout->slot  = 0U;
+}
+
+/**
+ * @brief       Initialize the Timing Wheel.
+ */
+void libTimeoutInit(void);
+
+/**
+ * @brief       Insert an entry into the Timing Wheel.
+ * @param[out]  timeout   timing wheel entry.
+ * @param[in]   time      absolute expiration time in ticks.
+ */
+void libTimeoutInsert(timeout_t *timeout, uint32_t time);
+
+/**
+ * @brief       Remove an entry from the Timing Wheel.
+ * @param[out]  timeout   timing wheel entry.
+ */
+void libTimeoutRemove(timeout_t *timeout);
+
+/**
+ * @brief       Process expired Thread Delays and Timers up to the current Kernel Tick.
+ * @return      true - Thread dispatch is required, false - otherwise.
+ */
+bool libTimeoutTick(void);
+
+/**
+ * @brief       Get the number of ticks until the next Timing Wheel event.
+ * @return      number of ticks or osWaitForever if the Timing Wheel is empty.
+ */
+uint32_t libTimeoutNext(void);
+
+
 /* Timer */
 
 void libTimerInsert(osTimer_t *timer, uint32_t time);
@@ -260,6 +802,12 @@ void libTimerThread(void *argument);
  */
 void libMutexOwnerRelease(queue_t *que);
 
+/**
+ * @brief       Recalculate inherited priorities after a Thread stopped waiting for a Mutex.
+ * @param[in]   mutex     mutex object the Thread has been waiting for.
+ */
+void libMutexWaitAbort(osMutex_t *mutex);
+
 /**
  * @brief       Initialize Memory Pool.
  * @param[in]   block_count   maximum number of memory blocks in memory pool.
@@ -290,6 +838,41 @@ void *libMemoryPoolAlloc(osMemoryPoolInfo_t *mp_info);
  */
 osStatus_t libMemoryPoolFree(osMemoryPoolInfo_t *mp_info, void *block);
 
+/**
+ * @brief       Initialize Object Memory Pools.
+ */
+void libObjectPoolInit(void);
+
+/**
+ * @brief       Allocate a block from an Object Memory Pool.
+ * @param[in]   pool      Object Memory Pool index (osObjectPool*).
+ * @param[in]   size      required block size in bytes.
+ * @return      address of the allocated block or NULL in case the pool is not configured or exhausted.
+ */
+void *libObjectAlloc(uint32_t pool, uint32_t size);
+
+/**
+ * @brief       Return a block back to an Object Memory Pool.
+ * @param[in]   pool      Object Memory Pool index (osObjectPool*).
+ * @param[in]   block     address of the block allocated by libObjectAlloc.
+ */
+void libObjectFree(uint32_t pool, void *block);
+
+/**
+ * @brief       Initialize Memory Allocator size classes.
+ */
+void libMemAllocInit(void);
+
+/**
+ * @brief       Initialize the kernel Heap.
+ */
+void libHeapInit(void);
+
+/**
+ * @brief       Serve the remaining heap waiters after a Thread stopped waiting.
+ */
+void libHeapWaitAbort(void);
+
 /*******************************************************************************
  *  System Library functions
  ******************************************************************************/
@@ -58,7 +58,7 @@ extern "C"
   #warning Not supported compiler type
 #endif
 
-/* Flags options (\ref osEventFlagsWait) */
+/* Flags options (\ref osThreadFlagsWait and \ref osEventFlagsWait) */
 #define osFlagsWaitAny                0x00000000U ///< Wait for any flag (default).
 #define osFlagsWaitAll                0x00000001U ///< Wait for all flags.
 #define osFlagsNoClear                0x00000002U ///< Do not clear flags which have been specified to wait for.
@@ -71,6 +71,10 @@ extern "C"
 #define osMutexPrioInherit            (1UL<<0)  ///< Priority inherit protocol.
 #define osMutexRecursive              (1UL<<1)  ///< Recursive mutex.
 #define osMutexRobust                 (1UL<<2)  ///< Robust mutex.
+#define osMutexPrioCeiling            (1UL<<3)  ///< Priority ceiling protocol.
+
+/* Data Queue attributes */
+#define osDataQueueSpsc               (1UL<<0)  ///< Lock-free single producer / single consumer ring.
 
 /* Timeout value */
 #define osWaitForever                 (0xFFFFFFFF)
@@ -203,6 +207,21 @@ typedef struct queue_s {
   struct queue_s *prev;
 } queue_t;
 
+/* Timing wheel entry */
+typedef struct timeout_s {
+  queue_t                         que;  ///< Entry is used to include object in the timing wheel
+  uint32_t                       time;  ///< Expiration time
+  uint8_t                       owner;  ///< Owner object identifier (thread or timer)
+  uint8_t                        slot;  ///< Timing wheel slot index
+  uint16_t                   reserved;
+} timeout_t;
+
+/* Wait queue (per-priority FIFO lists with occupancy bitmap) */
+typedef struct wait_queue_s {
+  uint32_t                        bmp;  ///< Bitmap of non-empty priority lists
+  queue_t         list[osPriorityISR];  ///< Waiting Threads lists (one per priority)
+} wait_queue_t;
+
 /* Timer Function Information */
 typedef struct osTimerFinfo_s {
   osTimerFunc_t                  func;  ///< Function Pointer
@@ -216,8 +235,18 @@ typedef struct winfo_msgque_s {
 
 typedef struct winfo_dataque_s {
   uint32_t  data_ptr;
+  uint32_t  count;
 } winfo_dataque_t;
 
+typedef struct winfo_stream_s {
+  uint32_t  data_ptr;
+  uint32_t  size;
+} winfo_stream_t;
+
+typedef struct winfo_heap_s {
+  uint32_t  size;
+} winfo_heap_t;
+
 typedef struct winfo_event_s {
   uint32_t flags;
   uint32_t options;
@@ -230,6 +259,8 @@ typedef struct winfo_s {
   union {
     winfo_msgque_t  msgque;
     winfo_dataque_t dataque;
+    winfo_stream_t  stream;
+    winfo_heap_t    heap;
     winfo_event_t   event;
   };
   uint32_t ret_val;
@@ -256,24 +287,49 @@ typedef void *osMessageQueueId_t;
 /// \details Data Queue ID identifies the data queue.
 typedef void *osDataQueueId_t;
 
+/// \details Stream Buffer ID identifies the stream buffer.
+typedef void *osStreamBufferId_t;
+
+/// \details Message Buffer ID identifies the message buffer.
+typedef void *osMessageBufferId_t;
+
 /// \details Memory Pool ID identifies the memory pool.
 typedef void *osMemoryPoolId_t;
 
+/// Thread runtime statistics (see \ref osThreadGetRuntime).
+typedef struct osThreadRuntime_s {
+  uint64_t                     cycles;  ///< Execution time in cycle counter units
+  uint32_t                  switch_in;  ///< Number of switches to the thread
+  uint32_t                 switch_out;  ///< Number of switches from the thread
+  uint32_t                   last_run;  ///< Kernel tick of the last switch to the thread
+} osThreadRuntime_t;
+
 /* Thread Control Block */
 typedef struct osThread_s {
   uint32_t                        stk;  ///< Address of thread's top of stack
   queue_t                  thread_que;  ///< Queue is used to include thread in ready/wait lists
   queue_t                   mutex_que;  ///< List of all mutexes that tack locked
+  queue_t                   flags_que;  ///< Queue is used to include thread in event flags wait list
   void                       *stk_mem;  ///< Base address of thread's stack space
   uint32_t                   stk_size;  ///< Task's stack size (in bytes)
   int8_t                base_priority;  ///< Task base priority
   int8_t                     priority;  ///< Task current priority
   uint8_t                          id;  ///< ID for verification(is it a thread or another object?)
   uint8_t                       state;  ///< Task state
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                        attr;  ///< Object Attributes
   const char                    *name;  ///< Object Name
   winfo_t                       winfo;  ///< Wait information
-  queue_t                   delay_que;  ///< Queue is used to include thread id delay list
-  uint32_t                      delay;  ///< Delay Time
+  wait_queue_t            *wait_queue;  ///< Wait queue the thread is blocked on
+  timeout_t                     delay;  ///< Entry is used to include thread in the timing wheel
+  uint32_t                 time_slice;  ///< Round-Robin Time Slice (in ticks)
+  uint32_t                 slice_left;  ///< Ticks left in the current Time Slice
+  osThreadRuntime_t           runtime;  ///< Runtime statistics
+  uint32_t               thread_flags;  ///< Thread Flags
+  uint32_t                 wait_flags;  ///< Thread Flags to wait for (0 - not waiting)
+  struct osMutex_s        *wait_mutex;  ///< Mutex the thread was last blocked on
+  struct osThread_s      *thread_join;  ///< Thread waiting to Join this thread
+  struct osThread_s      *join_thread;  ///< Thread being joined (NULL - not joining)
 } osThread_t;
 
 /* Semaphore Control Block */
@@ -283,7 +339,7 @@ typedef struct osSemaphore_s {
   uint8_t                       flags;  ///< Object Flags
   uint8_t                    reserved;
   const char                    *name;  ///< Object Name
-  queue_t                  wait_queue;  ///< Waiting Threads queue
+  wait_queue_t             wait_queue;  ///< Waiting Threads queue
   uint16_t                      count;  ///< Current number of tokens
   uint16_t                  max_count;  ///< Maximum number of tokens
 } osSemaphore_t;
@@ -295,12 +351,19 @@ typedef struct osEventFlags_s {
   uint8_t                       flags;  ///< Object Flags
   uint8_t                    reserved;
   const char                    *name;  ///< Object Name
-  queue_t                  wait_queue;  ///< Waiting Threads queue
   uint32_t                event_flags;  ///< Initial value of the eventflag bit pattern
+  uint32_t                   wait_bmp;  ///< Non-empty wait lists bitmap
+  uint32_t              wait_mask[31];  ///< Flags that can wake the Threads of each wait list
+  queue_t               wait_list[31];  ///< Waiting Threads (FIFO) indexed by the flag that can wake them
 } osEventFlags_t;
 
 /* - Memory Pool definitions   -----------------------------------------------*/
 
+/* Memory Allocator size classes: 16, 32, 64, 128, 256 and 512 bytes */
+#define osMemClassNum                 6U
+#define osMemClassSizeMin             16U
+#define osMemClassSizeMax             (osMemClassSizeMin << (osMemClassNum - 1U))
+
 /* Memory Pool Information */
 typedef struct osMemoryPoolInfo_s {
   uint32_t                 max_blocks;  ///< Maximum number of Blocks
@@ -309,6 +372,7 @@ typedef struct osMemoryPoolInfo_s {
   void                    *block_base;  ///< Block Memory Base Address
   void                     *block_lim;  ///< Block Memory Limit Address
   void                    *block_free;  ///< First free Block Address
+  void                     *block_hwm;  ///< First Block never allocated (High-Water Mark)
 } osMemoryPoolInfo_t;
 
 /* Memory Pool Control Block */
@@ -318,19 +382,19 @@ typedef struct osMemoryPool_s {
   uint8_t                       flags;  ///< Object Flags
   uint8_t                    reserved;
   const char                    *name;  ///< Object Name
-  queue_t                  wait_queue;  ///< Waiting Threads queue
+  wait_queue_t             wait_queue;  ///< Waiting Threads queue
   osMemoryPoolInfo_t             info;  ///< Memory Pool Info
 } osMemoryPool_t;
 
 /* - Message Queue definitions   -----------------------------------------------*/
 
-/* Message Control Block */
+/* Message Control Block (the free block link overlays msg_que, not the identifier) */
 typedef struct osMessage_s {
+  queue_t                     msg_que;  ///< Entry is used to include message in the list
   uint8_t                          id;  ///< Object Identifier
   uint8_t              reserved_state;  ///< Object State (not used)
   uint8_t                       flags;  ///< Object Flags
   uint8_t                    priority;  ///< Message Priority
-  queue_t                     msg_que;  ///< Entry is used to include message in the list
 } osMessage_t;
 
 /* Message Queue Control Block */
@@ -340,12 +404,16 @@ typedef struct osMessageQueue_s {
   uint8_t                       flags;  ///< Object Flags
   uint8_t                    reserved;
   const char                    *name;  ///< Object Name
-  queue_t              wait_put_queue;  ///< Queue of threads waiting to send a message
-  queue_t              wait_get_queue;  ///< Queue of threads waiting to receive a message
+  wait_queue_t         wait_put_queue;  ///< Queue of threads waiting to send a message
+  wait_queue_t         wait_get_queue;  ///< Queue of threads waiting to receive a message
   osMemoryPoolInfo_t          mp_info;  ///< Memory Pool Info
   uint32_t                   msg_size;  ///< Message size in bytes
   uint32_t                  msg_count;  ///< Number of queued Messages
   queue_t                   msg_queue;  ///< List of all queued Messages
+  queue_t                   msg_reset;  ///< Messages dropped by Reset, reused before the Memory Pool
+  uint32_t                   prio_grp;  ///< Occupied groups of 32 Message Priorities
+  uint32_t                prio_bmp[8];  ///< Occupied Message Priorities
+  osMessage_t         *prio_tail[256];  ///< Last queued Message of each Priority
 } osMessageQueue_t;
 
 /* Data Queue Control Block */
@@ -353,19 +421,36 @@ typedef struct osDataQueue_s {
   uint8_t                          id;  ///< Object Identifier
   uint8_t              reserved_state;  ///< Object State (not used)
   uint8_t                       flags;  ///< Object Flags
-  uint8_t                    reserved;
+  uint8_t                        attr;  ///< Object Attributes
   const char                    *name;  ///< Object Name
-  queue_t              wait_put_queue;  ///< Queue of threads waiting to send a data
-  queue_t              wait_get_queue;  ///< Queue of threads waiting to receive a data
+  wait_queue_t         wait_put_queue;  ///< Queue of threads waiting to send a data
+  wait_queue_t         wait_get_queue;  ///< Queue of threads waiting to receive a data
   uint32_t             max_data_count;  ///< Maximum number of Data
   uint32_t                  data_size;  ///< Data size in bytes
   uint32_t                 data_count;  ///< Number of queued Data
   uint32_t                 data_limit;  ///< Data Limit
-  uint32_t                       head;
-  uint32_t                       tail;
+  uint32_t                       head;  ///< Write offset (element index with osDataQueueSpsc)
+  uint32_t                       tail;  ///< Read offset (element index with osDataQueueSpsc)
   uint8_t                     *dq_mem;  ///< Data Memory Address
 } osDataQueue_t;
 
+/* Stream Buffer Control Block */
+typedef struct osStreamBuffer_s {
+  uint8_t                          id;  ///< Object Identifier
+  uint8_t              reserved_state;  ///< Object State (not used)
+  uint8_t                       flags;  ///< Object Flags
+  uint8_t                        attr;  ///< Object Attributes
+  const char                    *name;  ///< Object Name
+  wait_queue_t         wait_put_queue;  ///< Queue of threads waiting to write data
+  wait_queue_t         wait_get_queue;  ///< Queue of threads waiting to read data
+  uint32_t                       size;  ///< Buffer size in bytes
+  uint32_t                      count;  ///< Number of stored bytes
+  uint32_t                    trigger;  ///< Number of bytes that unblock a waiting reader
+  uint32_t                       head;  ///< Write offset
+  uint32_t                       tail;  ///< Read offset
+  uint8_t                     *sb_mem;  ///< Data Memory Address
+} osStreamBuffer_t;
+
 /* Mutex Control Block */
 typedef struct osMutex_s {
   uint8_t                          id;  ///< Object Identifier
@@ -373,10 +458,11 @@ typedef struct osMutex_s {
   uint8_t                       flags;  ///< Object Flags
   uint8_t                        attr;  ///< Object Attributes
   const char                    *name;  ///< Object Name
-  queue_t                    wait_que;  ///< List of tasks that wait a mutex
+  wait_queue_t               wait_que;  ///< List of tasks that wait a mutex
   queue_t                   mutex_que;  ///< To include in thread's locked mutexes list (if any)
   osThread_t                  *holder;  ///< Current mutex owner(thread that locked mutex)
   uint32_t                        cnt;  ///< Lock counter
+  int8_t                 prio_ceiling;  ///< Ceiling priority (osMutexPrioCeiling)
 } osMutex_t;
 
 /* Timer Control Block */
@@ -387,8 +473,7 @@ typedef struct osTimer_s {
   uint8_t                        type;  ///< Timer Type (Periodic/One-shot)
   const char                    *name;  ///< Object Name
   uint32_t                       load;  ///< Timer Load value
-  uint32_t                       time;  ///< Event time
-  queue_t                   timer_que;  ///< Timer event queue
+  timeout_t                   timeout;  ///< Entry is used to include timer in the timing wheel
   osTimerFinfo_t                finfo;  ///< Timer Function Info
 } osTimer_t;
 
@@ -409,6 +494,7 @@ typedef struct {
   osPriority_t              priority;   ///< initial thread priority (default: osPriorityNormal)
   TZ_ModuleId_t            tz_module;   ///< TrustZone module identifier
   uint32_t                  reserved;   ///< reserved (must be 0)
+  uint32_t                time_slice;   ///< round-robin time slice in ticks (0: OS_ROBIN_TIMEOUT if OS_ROBIN_ENABLE, else none)
 } osThreadAttr_t;
 
 /// Attributes structure for timer.
@@ -441,6 +527,7 @@ typedef struct {
   uint32_t                 attr_bits;   ///< attribute bits
   void                       *cb_mem;   ///< memory for control block
   uint32_t                   cb_size;   ///< size of provided memory for control block
+  osPriority_t          prio_ceiling;   ///< ceiling priority (\ref osMutexPrioCeiling)
 } osMutexAttr_t;
 
 /// Attributes structure for message queue.
@@ -463,6 +550,19 @@ typedef struct osDataQueueAttr_s {
   uint32_t                   dq_size;   ///< size of provided memory for data storage
 } osDataQueueAttr_t;
 
+/// Attributes structure for stream buffer.
+typedef struct osStreamBufferAttr_s {
+  const char                   *name;   ///< name of the stream buffer
+  uint32_t                 attr_bits;   ///< attribute bits
+  void                       *cb_mem;   ///< memory for control block
+  uint32_t                   cb_size;   ///< size of provided memory for control block
+  void                       *sb_mem;   ///< memory for data storage
+  uint32_t                   sb_size;   ///< size of provided memory for data storage
+} osStreamBufferAttr_t;
+
+/// Attributes structure for message buffer (sb_mem/sb_size provide the data storage).
+typedef osStreamBufferAttr_t osMessageBufferAttr_t;
+
 /// Attributes structure for memory pool.
 typedef struct {
   const char                   *name;   ///< name of the memory pool
@@ -473,6 +573,27 @@ typedef struct {
   uint32_t                   mp_size;   ///< size of provided memory for data storage
 } osMemoryPoolAttr_t;
 
+/// Statistics of a Memory Allocator size class.
+typedef struct osMemStats_s {
+  uint32_t                block_size;   ///< block size of the class in bytes
+  uint32_t                  capacity;   ///< number of blocks (0 - class is not configured)
+  uint32_t                      used;   ///< number of blocks in use
+  uint32_t                  max_used;   ///< maximum number of blocks in use
+  uint32_t                fail_count;   ///< number of requests the class could not serve immediately
+} osMemStats_t;
+
+/// Statistics of the kernel Heap.
+typedef struct osHeapStats_s {
+  uint32_t                total_size;   ///< heap size available for allocations in bytes
+  uint32_t                 free_size;   ///< free space in bytes
+  uint32_t             min_free_size;   ///< minimum free space since kernel initialization in bytes
+  uint32_t              largest_free;   ///< largest free block in bytes
+  uint32_t               used_blocks;   ///< number of allocated blocks
+  uint32_t               free_blocks;   ///< number of free blocks
+  uint32_t                fail_count;   ///< number of requests that could not be served immediately
+  uint32_t             fragmentation;   ///< fragmentation index in percent (100 * (1 - largest_free / free_size))
+} osHeapStats_t;
+
 /*******************************************************************************
  *  exported variables
  ******************************************************************************/
@@ -485,6 +606,9 @@ typedef struct {
 extern void osIdleThread(void *argument);
 /* SysTick timer initialization */
 extern void osSysTickInit(uint32_t hz);
+/* Sleep until the given number of ticks elapsed or an interrupt occurred.
+   Called with interrupts disabled (PRIMASK set), WFI still wakes on a pending interrupt. */
+extern uint32_t osSysTickSleep(uint32_t ticks);
 
 /*******************************************************************************
  *  Kernel Information and Control
@@ -543,6 +667,28 @@ int32_t osKernelUnlock(void);
  */
 int32_t osKernelRestoreLock(int32_t lock);
 
+/**
+ * @fn          uint32_t osKernelSuspend(void)
+ * @brief       Suspend the RTOS Kernel scheduler.
+ * @return      time in ticks, for how long the system can sleep or power-down.
+ */
+uint32_t osKernelSuspend(void);
+
+/**
+ * @fn          void osKernelResume(uint32_t sleep_ticks)
+ * @brief       Resume the RTOS Kernel scheduler.
+ * @param[in]   sleep_ticks   time in ticks for how long the system was in sleep or power-down mode.
+ */
+void osKernelResume(uint32_t sleep_ticks);
+
+/**
+ * @fn          uint32_t osKernelWakeupPending(void)
+ * @brief       Check if a Thread of higher priority than the running one is ready.
+ * @return      1 if the Kernel must not sleep, 0 otherwise.
+ * @note        Can be called with interrupts disabled.
+ */
+uint32_t osKernelWakeupPending(void);
+
 /**
  * @fn          uint32_t osKernelGetTickCount(void)
  * @brief       Get the RTOS kernel tick count.
@@ -557,6 +703,13 @@ uint32_t osKernelGetTickCount(void);
  */
 uint32_t osKernelGetTickFreq(void);
 
+/**
+ * @fn          uint32_t osKernelGetIdlePercent(void)
+ * @brief       Get the share of time spent in the Idle Thread since the kernel start.
+ * @return      idle time in percent or 0 if thread runtime statistics are disabled.
+ */
+uint32_t osKernelGetIdlePercent(void);
+
 /*******************************************************************************
  *  Timer Management
  ******************************************************************************/
@@ -666,6 +819,15 @@ uint32_t osThreadGetStackSize(osThreadId_t thread_id);
  */
 uint32_t osThreadGetStackSpace(osThreadId_t thread_id);
 
+/**
+ * @fn          osStatus_t osThreadGetRuntime(osThreadId_t thread_id, osThreadRuntime_t *runtime)
+ * @brief       Get runtime statistics of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[out]  runtime     pointer to buffer for the runtime statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadGetRuntime(osThreadId_t thread_id, osThreadRuntime_t *runtime);
+
 /**
  * @fn          osStatus_t osThreadSetPriority(osThreadId_t thread_id, osPriority_t priority)
  * @brief       Change priority of a thread.
@@ -706,6 +868,22 @@ osStatus_t osThreadSuspend(osThreadId_t thread_id);
  */
 osStatus_t osThreadResume(osThreadId_t thread_id);
 
+/**
+ * @fn          osStatus_t osThreadDetach(osThreadId_t thread_id)
+ * @brief       Detach a thread (thread storage can be reclaimed when thread terminates).
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadDetach(osThreadId_t thread_id);
+
+/**
+ * @fn          osStatus_t osThreadJoin(osThreadId_t thread_id)
+ * @brief       Wait for specified thread to terminate.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadJoin(osThreadId_t thread_id);
+
 /**
  * @fn          void osThreadExit(void)
  * @brief       Terminate execution of current running thread.
@@ -736,6 +914,44 @@ uint32_t osThreadGetCount(void);
  */
 uint32_t osThreadEnumerate(osThreadId_t *thread_array, uint32_t array_items);
 
+/*******************************************************************************
+ *  Thread Flags Functions
+ ******************************************************************************/
+
+/**
+ * @fn          uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+ * @brief       Set the specified Thread Flags of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   flags       specifies the flags of the thread that shall be set.
+ * @return      thread flags after setting or error code if highest bit set.
+ */
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+
+/**
+ * @fn          uint32_t osThreadFlagsClear(uint32_t flags)
+ * @brief       Clear the specified Thread Flags of current running thread.
+ * @param[in]   flags   specifies the flags of the thread that shall be cleared.
+ * @return      thread flags before clearing or error code if highest bit set.
+ */
+uint32_t osThreadFlagsClear(uint32_t flags);
+
+/**
+ * @fn          uint32_t osThreadFlagsGet(void)
+ * @brief       Get the current Thread Flags of current running thread.
+ * @return      current thread flags.
+ */
+uint32_t osThreadFlagsGet(void);
+
+/**
+ * @fn          uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
+ * @brief       Wait for one or more Thread Flags of the current running thread to become signaled.
+ * @param[in]   flags     specifies the flags to wait for.
+ * @param[in]   options   specifies flags options (osFlagsXxxx).
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      thread flags before clearing or error code if highest bit set.
+ */
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+
 /*******************************************************************************
  *  Generic Wait Functions
  ******************************************************************************/
@@ -856,6 +1072,45 @@ osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint
  */
 osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout);
 
+/**
+ * @fn          void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+ * @brief       Allocate a Message block to be filled in place and sent with \ref osMessageQueueSend.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      pointer to message data or NULL in case of no memory is available.
+ */
+void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout);
+
+/**
+ * @fn          osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+ * @brief       Put a Message block allocated by \ref osMessageQueueAlloc into a Queue without copying.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   pointer to message data obtained by \ref osMessageQueueAlloc.
+ * @param[in]   msg_prio  message priority.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio);
+
+/**
+ * @fn          void *osMessageQueueReceive(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+ * @brief       Take a Message out of a Queue without copying or timeout if Queue is empty.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[out]  msg_prio  pointer to buffer for message priority or NULL.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      pointer to message data or NULL in case of no message is available.
+ * @note        The block must be returned with \ref osMessageQueueRelease.
+ */
+void *osMessageQueueReceive(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout);
+
+/**
+ * @fn          osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+ * @brief       Return a Message block obtained by \ref osMessageQueueReceive or \ref osMessageQueueAlloc.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   pointer to message data.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr);
+
 /**
  * @fn          uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id)
  * @brief       Get maximum number of messages in a Message Queue.
@@ -893,6 +1148,8 @@ uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id);
  * @brief       Reset a Message Queue to initial empty state.
  * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
  * @return      status code that indicates the execution status of the function.
+ * @note        Runs in constant time. Blocks held by \ref osMessageQueueAlloc or
+ *              \ref osMessageQueueReceive stay valid.
  */
 osStatus_t osMessageQueueReset(osMessageQueueId_t mq_id);
 
@@ -946,6 +1203,28 @@ osStatus_t osDataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, uint32_t
  */
 osStatus_t osDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeout);
 
+/**
+ * @fn          uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Put up to count Data into a Queue or timeout if Queue is full.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[in]   data_ptr  pointer to buffer with data to put into a queue.
+ * @param[in]   count     number of data in the buffer.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data put into the queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Get up to count Data from a Queue or timeout if Queue is empty.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[out]  data_ptr  pointer to buffer for data to get from a queue.
+ * @param[in]   count     number of data the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data got from the queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout);
+
 /**
  * @fn          uint32_t osDataQueueGetCapacity(osDataQueueId_t dq_id)
  * @brief       Get maximum number of data in a Data Queue.
@@ -994,6 +1273,166 @@ osStatus_t osDataQueueReset(osDataQueueId_t dq_id);
  */
 osStatus_t osDataQueueDelete(osDataQueueId_t dq_id);
 
+/*******************************************************************************
+ *  Stream Buffer
+ ******************************************************************************/
+
+/**
+ * @fn          osStreamBufferId_t osStreamBufferNew(uint32_t size, uint32_t trigger_level, const osStreamBufferAttr_t *attr)
+ * @brief       Create and Initialize a Stream Buffer object.
+ * @param[in]   size            buffer size in bytes.
+ * @param[in]   trigger_level   number of bytes that unblock a waiting reader (0 - same as 1).
+ * @param[in]   attr            stream buffer attributes.
+ * @return      stream buffer ID for reference by other functions or NULL in case of error.
+ */
+osStreamBufferId_t osStreamBufferNew(uint32_t size, uint32_t trigger_level, const osStreamBufferAttr_t *attr);
+
+/**
+ * @fn          const char *osStreamBufferGetName(osStreamBufferId_t sb_id)
+ * @brief       Get name of a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osStreamBufferGetName(osStreamBufferId_t sb_id);
+
+/**
+ * @fn          uint32_t osStreamBufferSend(osStreamBufferId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Write bytes into a Stream Buffer or timeout if there is not enough space.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamBufferNew.
+ * @param[in]   data_ptr  pointer to buffer with data to write.
+ * @param[in]   size      number of bytes to write.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes written.
+ */
+uint32_t osStreamBufferSend(osStreamBufferId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osStreamBufferReceive(osStreamBufferId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Read bytes from a Stream Buffer or timeout if less than the trigger level is stored.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamBufferNew.
+ * @param[out]  data_ptr  pointer to buffer for data to read.
+ * @param[in]   size      maximum number of bytes to read.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes read.
+ */
+uint32_t osStreamBufferReceive(osStreamBufferId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout);
+
+/**
+ * @fn          osStatus_t osStreamBufferSetTriggerLevel(osStreamBufferId_t sb_id, uint32_t trigger_level)
+ * @brief       Set the number of bytes that unblock a waiting reader.
+ * @param[in]   sb_id           stream buffer ID obtained by \ref osStreamBufferNew.
+ * @param[in]   trigger_level   trigger level in bytes (0 - same as 1).
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamBufferSetTriggerLevel(osStreamBufferId_t sb_id, uint32_t trigger_level);
+
+/**
+ * @fn          uint32_t osStreamBufferGetCount(osStreamBufferId_t sb_id)
+ * @brief       Get number of bytes stored in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      number of stored bytes.
+ */
+uint32_t osStreamBufferGetCount(osStreamBufferId_t sb_id);
+
+/**
+ * @fn          uint32_t osStreamBufferGetSpace(osStreamBufferId_t sb_id)
+ * @brief       Get number of free bytes in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      number of free bytes.
+ */
+uint32_t osStreamBufferGetSpace(osStreamBufferId_t sb_id);
+
+/**
+ * @fn          osStatus_t osStreamBufferReset(osStreamBufferId_t sb_id)
+ * @brief       Reset a Stream Buffer to initial empty state.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamBufferReset(osStreamBufferId_t sb_id);
+
+/**
+ * @fn          osStatus_t osStreamBufferDelete(osStreamBufferId_t sb_id)
+ * @brief       Delete a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamBufferDelete(osStreamBufferId_t sb_id);
+
+/*******************************************************************************
+ *  Message Buffer
+ ******************************************************************************/
+
+/**
+ * @fn          osMessageBufferId_t osMessageBufferNew(uint32_t size, const osMessageBufferAttr_t *attr)
+ * @brief       Create and Initialize a Message Buffer object.
+ * @param[in]   size    buffer size in bytes (each message takes its size plus 2 bytes).
+ * @param[in]   attr    message buffer attributes.
+ * @return      message buffer ID for reference by other functions or NULL in case of error.
+ */
+osMessageBufferId_t osMessageBufferNew(uint32_t size, const osMessageBufferAttr_t *attr);
+
+/**
+ * @fn          const char *osMessageBufferGetName(osMessageBufferId_t mb_id)
+ * @brief       Get name of a Message Buffer object.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osMessageBufferGetName(osMessageBufferId_t mb_id);
+
+/**
+ * @fn          osStatus_t osMessageBufferSend(osMessageBufferId_t mb_id, const void *msg_ptr, uint32_t msg_size, uint32_t timeout)
+ * @brief       Put a Message into a Message Buffer or timeout if there is not enough space.
+ * @param[in]   mb_id     message buffer ID obtained by \ref osMessageBufferNew.
+ * @param[in]   msg_ptr   pointer to message.
+ * @param[in]   msg_size  message size in bytes (1..65535).
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageBufferSend(osMessageBufferId_t mb_id, const void *msg_ptr, uint32_t msg_size, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osMessageBufferReceive(osMessageBufferId_t mb_id, void *msg_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Get a Message from a Message Buffer or timeout if it is empty.
+ * @param[in]   mb_id     message buffer ID obtained by \ref osMessageBufferNew.
+ * @param[out]  msg_ptr   pointer to buffer for message.
+ * @param[in]   size      size of the buffer in bytes.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      message size or 0 in case of no message or the message does not fit into the buffer.
+ */
+uint32_t osMessageBufferReceive(osMessageBufferId_t mb_id, void *msg_ptr, uint32_t size, uint32_t timeout);
+
+/**
+ * @fn          uint32_t osMessageBufferGetNextSize(osMessageBufferId_t mb_id)
+ * @brief       Get size of the next Message in a Message Buffer.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      message size or 0 in case the Message Buffer is empty.
+ */
+uint32_t osMessageBufferGetNextSize(osMessageBufferId_t mb_id);
+
+/**
+ * @fn          uint32_t osMessageBufferGetSpace(osMessageBufferId_t mb_id)
+ * @brief       Get size of the largest Message that can be put into a Message Buffer.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      message size in bytes.
+ */
+uint32_t osMessageBufferGetSpace(osMessageBufferId_t mb_id);
+
+/**
+ * @fn          osStatus_t osMessageBufferReset(osMessageBufferId_t mb_id)
+ * @brief       Reset a Message Buffer to initial empty state.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageBufferReset(osMessageBufferId_t mb_id);
+
+/**
+ * @fn          osStatus_t osMessageBufferDelete(osMessageBufferId_t mb_id)
+ * @brief       Delete a Message Buffer object.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageBufferDelete(osMessageBufferId_t mb_id);
+
 /*******************************************************************************
  *  Event Flags
  ******************************************************************************/
@@ -1140,6 +1579,67 @@ uint32_t osMemoryPoolGetSpace(osMemoryPoolId_t mp_id);
  */
 osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id);
 
+/*******************************************************************************
+ *  Memory Allocator
+ ******************************************************************************/
+
+/**
+ * @fn          void *osMemAlloc(uint32_t size, uint32_t timeout)
+ * @brief       Allocate a memory block from the smallest size class that can hold size bytes.
+ * @param[in]   size      requested size in bytes (1..\ref osMemClassSizeMax).
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *osMemAlloc(uint32_t size, uint32_t timeout);
+
+/**
+ * @fn          osStatus_t osMemFree(void *block)
+ * @brief       Return a memory block allocated by \ref osMemAlloc.
+ * @param[in]   block   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemFree(void *block);
+
+/**
+ * @fn          osStatus_t osMemGetStats(uint32_t class_idx, osMemStats_t *stats)
+ * @brief       Get usage statistics of a Memory Allocator size class.
+ * @param[in]   class_idx   size class index (0..\ref osMemClassNum - 1).
+ * @param[out]  stats       pointer to buffer for statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemGetStats(uint32_t class_idx, osMemStats_t *stats);
+
+/*******************************************************************************
+ *  Heap
+ ******************************************************************************/
+
+/**
+ * @fn          void *osHeapAlloc(uint32_t size, uint32_t timeout)
+ * @brief       Allocate a memory block of arbitrary size from the kernel Heap.
+ * @param[in]   size      requested size in bytes.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ * @note        Waiting Threads are served in priority order and a request does not
+ *              overtake a waiting one. Requests larger than the heap fail at once.
+ */
+void *osHeapAlloc(uint32_t size, uint32_t timeout);
+
+/**
+ * @fn          osStatus_t osHeapFree(void *block)
+ * @brief       Return a memory block allocated by \ref osHeapAlloc.
+ * @param[in]   block   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapFree(void *block);
+
+/**
+ * @fn          osStatus_t osHeapGetStats(osHeapStats_t *stats)
+ * @brief       Get usage and fragmentation statistics of the kernel Heap.
+ * @param[out]  stats   pointer to buffer for statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapGetStats(osHeapStats_t *stats);
+
 
 /*******************************************************************************
  *  Mutex Management
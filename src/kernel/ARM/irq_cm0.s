@@ -31,12 +31,24 @@ irqLib          DCB       0                   ; Non weak library reference
 PendSV_Handler  PROC
                 EXPORT    PendSV_Handler
                 IMPORT    osInfo
+                IMPORT    libThreadRuntimeSwitch
+                IMPORT    libIsrQueueProcess
+
+                PUSH      {R0,LR}             ; Save EXC_RETURN
+                BL        libIsrQueueProcess  ; Process deferred ISR calls
+                POP       {R0,R1}             ; Restore EXC_RETURN
+                MOV       LR,R1               ; Set EXC_RETURN
 
                 LDR       R3,=osInfo          ; in R3 - =run_task
                 LDM       R3!,{R1,R2}         ; in R1 - current run task, in R2 - next run task
                 CMP       R1,R2               ; Check if thread switch is required
                 BEQ       Context_Exit        ; Exit when threads are the same
 
+                BL        libThreadRuntimeSwitch ; Account the thread switch
+
+                LDR       R3,=osInfo          ; in R3 - =run_task
+                LDM       R3!,{R1,R2}         ; in R1 - current run task, in R2 - next run task
+
                 CMP       R1,#0
                 BEQ       Context_Switch      ; Branch if running thread is deleted
 ContextSave
@@ -31,12 +31,23 @@ irqLib          DCB       0                   ; Non weak library reference
 PendSV_Handler  PROC
                 EXPORT    PendSV_Handler
                 IMPORT    osInfo
+                IMPORT    libThreadRuntimeSwitch
+                IMPORT    libIsrQueueProcess
+
+                PUSH      {R0,LR}             ; Save EXC_RETURN
+                BL        libIsrQueueProcess  ; Process deferred ISR calls
+                POP       {R0,LR}             ; Restore EXC_RETURN
 
                 LDR       R3,=osInfo          ; in R3 - =run_task
                 LDM       R3,{R1,R2}          ; in R1 - current run task, in R2 - next run task
                 CMP       R1,R2               ; Check if thread switch is required
                 BEQ       Context_Exit        ; Exit when threads are the same
 
+                BL        libThreadRuntimeSwitch ; Account the thread switch
+
+                LDR       R3,=osInfo          ; in R3 - =run_task
+                LDM       R3,{R1,R2}          ; in R1 - current run task, in R2 - next run task
+
                 CBZ       R1,Context_Switch   ; Branch if running thread is deleted
 ContextSave
                 MRS       R0,PSP              ; in PSP - process(task) stack pointer
@@ -92,32 +92,501 @@ static bool DataGet(osDataQueue_t *dq, void *data_ptr)
   return (true);
 }
 
+/**
+ * @brief       Copy up to count Data into the ring buffer.
+ * @param[in]   dq        data queue object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   count     number of data in the buffer.
+ * @return      number of data copied.
+ */
+static uint32_t DataPutN(osDataQueue_t *dq, const uint8_t *data_ptr, uint32_t count)
+{
+  uint32_t size;
+  uint32_t span;
+
+  if (count > (dq->max_data_count - dq->data_count)) {
+    count = dq->max_data_count - dq->data_count;
+  }
+  if (count == 0U) {
+    return (0U);
+  }
+
+  /* Copy in at most two contiguous spans */
+  size = count * dq->data_size;
+  span = dq->data_limit - dq->head;
+  if (span > size) {
+    span = size;
+  }
+  memcpy(&dq->dq_mem[dq->head], data_ptr, span);
+  if (span < size) {
+    memcpy(&dq->dq_mem[0], &data_ptr[span], size - span);
+  }
+
+  dq->head += size;
+  if (dq->head >= dq->data_limit) {
+    dq->head -= dq->data_limit;
+  }
+
+  dq->data_count += count;
+
+  return (count);
+}
+
+/**
+ * @brief       Copy up to count Data out of the ring buffer.
+ * @param[in]   dq        data queue object.
+ * @param[out]  data_ptr  pointer to buffer for data.
+ * @param[in]   count     number of data the buffer can hold.
+ * @return      number of data copied.
+ */
+static uint32_t DataGetN(osDataQueue_t *dq, uint8_t *data_ptr, uint32_t count)
+{
+  uint32_t size;
+  uint32_t span;
+
+  if (count > dq->data_count) {
+    count = dq->data_count;
+  }
+  if (count == 0U) {
+    return (0U);
+  }
+
+  /* Copy out at most two contiguous spans */
+  size = count * dq->data_size;
+  span = dq->data_limit - dq->tail;
+  if (span > size) {
+    span = size;
+  }
+  memcpy(data_ptr, &dq->dq_mem[dq->tail], span);
+  if (span < size) {
+    memcpy(&data_ptr[span], &dq->dq_mem[0], size - span);
+  }
+
+  dq->data_count -= count;
+  dq->tail += size;
+  if (dq->tail >= dq->data_limit) {
+    dq->tail -= dq->data_limit;
+  }
+
+  return (count);
+}
+
+/**
+ * @brief       Pass Data directly to Threads waiting to receive.
+ * @param[in]   dq        data queue object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   count     number of data in the buffer.
+ * @return      number of data passed.
+ * @note        Threads waiting in \ref osDataQueueGet have count == 0 and get osOK,
+ *              Threads waiting in \ref osDataQueueGetN get the number of data received.
+ */
+static uint32_t DataQueueWakeupGet(osDataQueue_t *dq, const uint8_t *data_ptr, uint32_t count)
+{
+  osThread_t      *thread;
+  winfo_dataque_t *winfo;
+  uint32_t         num;
+  uint32_t         done;
+
+  done = 0U;
+
+  while ((done < count) && !isWaitQueueEmpty(&dq->wait_get_queue)) {
+    /* Get waiting Thread with highest Priority */
+    thread = WaitQueueHead(&dq->wait_get_queue);
+    winfo = &thread->winfo.dataque;
+    num = (winfo->count == 0U) ? 1U : winfo->count;
+    if (num > (count - done)) {
+      num = count - done;
+    }
+    memcpy((void *)winfo->data_ptr, &data_ptr[done * dq->data_size], num * dq->data_size);
+    libThreadWaitExit(thread, (winfo->count == 0U) ? (uint32_t)osOK : num, DISPATCH_NO);
+    done += num;
+  }
+
+  return (done);
+}
+
+/**
+ * @brief       Fill the ring buffer with Data of Threads waiting to send.
+ * @param[in]   dq  data queue object.
+ */
+static void DataQueueWakeupPut(osDataQueue_t *dq)
+{
+  osThread_t      *thread;
+  winfo_dataque_t *winfo;
+  uint32_t         num;
+
+  while (!isWaitQueueEmpty(&dq->wait_put_queue)) {
+    /* Get waiting Thread with highest Priority */
+    thread = WaitQueueHead(&dq->wait_put_queue);
+    winfo = &thread->winfo.dataque;
+    /* Try to put data into Queue */
+    num = DataPutN(dq, (const uint8_t *)winfo->data_ptr, (winfo->count == 0U) ? 1U : winfo->count);
+    if (num == 0U) {
+      break;
+    }
+    libThreadWaitExit(thread, (winfo->count == 0U) ? (uint32_t)osOK : num, DISPATCH_NO);
+  }
+}
+
+/**
+ * @brief       Check if a Data Queue is a lock-free single producer / single consumer ring.
+ * @param[in]   dq  data queue object.
+ * @return      true - osDataQueueSpsc queue, false - otherwise.
+ */
+static
+bool DataQueueIsSpsc(const osDataQueue_t *dq)
+{
+  return (((dq != NULL) && (dq->id == ID_DATA_QUEUE) && ((dq->attr & osDataQueueSpsc) != 0U)) ? true : false);
+}
+
+/**
+ * @brief       Write up to count Data into a single producer / single consumer ring.
+ * @param[in]   dq        data queue object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   count     number of data in the buffer.
+ * @return      number of data written.
+ * @note        Only the producer moves head, only the consumer moves tail,
+ *              so no critical section is required.
+ */
+static uint32_t DataSpscPut(osDataQueue_t *dq, const uint8_t *data_ptr, uint32_t count)
+{
+  uint32_t head;
+  uint32_t offset;
+  uint32_t size;
+  uint32_t span;
+
+  head = *(volatile uint32_t *)&dq->head;
+  span = dq->max_data_count - (head - *(volatile uint32_t *)&dq->tail);
+  if (count > span) {
+    count = span;
+  }
+  if (count == 0U) {
+    return (0U);
+  }
+
+  /* Copy in at most two contiguous spans */
+  offset = (head & (dq->max_data_count - 1U)) * dq->data_size;
+  size = count * dq->data_size;
+  span = dq->data_limit - offset;
+  if (span > size) {
+    span = size;
+  }
+  memcpy(&dq->dq_mem[offset], data_ptr, span);
+  if (span < size) {
+    memcpy(&dq->dq_mem[0], &data_ptr[span], size - span);
+  }
+
+  /* Publish data before the new head */
+  __DMB();
+  *(volatile uint32_t *)&dq->head = head + count;
+
+  return (count);
+}
+
+/**
+ * @brief       Read up to count Data from a single producer / single consumer ring.
+ * @param[in]   dq        data queue object.
+ * @param[out]  data_ptr  pointer to buffer for data.
+ * @param[in]   count     number of data the buffer can hold.
+ * @return      number of data read.
+ */
+static uint32_t DataSpscGet(osDataQueue_t *dq, uint8_t *data_ptr, uint32_t count)
+{
+  uint32_t tail;
+  uint32_t offset;
+  uint32_t size;
+  uint32_t span;
+
+  tail = *(volatile uint32_t *)&dq->tail;
+  span = *(volatile uint32_t *)&dq->head - tail;
+  if (count > span) {
+    count = span;
+  }
+  if (count == 0U) {
+    return (0U);
+  }
+  __DMB();
+
+  /* Copy out at most two contiguous spans */
+  offset = (tail & (dq->max_data_count - 1U)) * dq->data_size;
+  size = count * dq->data_size;
+  span = dq->data_limit - offset;
+  if (span > size) {
+    span = size;
+  }
+  memcpy(data_ptr, &dq->dq_mem[offset], span);
+  if (span < size) {
+    memcpy(&data_ptr[span], &dq->dq_mem[0], size - span);
+  }
+
+  /* Release the slots after the data is read */
+  __DMB();
+  *(volatile uint32_t *)&dq->tail = tail + count;
+
+  return (count);
+}
+
+/**
+ * @brief       Serve Threads blocked on a single producer / single consumer ring.
+ * @param[in]   object  data queue object.
+ * @note        Called by SVC, from ISR or deferred to PendSV when the other side
+ *              finds a Thread waiting. Woken Threads get the number of data transferred.
+ */
+static void DataQueueSpscPostProcess(void *object)
+{
+  osDataQueue_t   *dq = object;
+  osThread_t      *thread;
+  winfo_dataque_t *winfo;
+  uint32_t         num;
+
+  /* Check object state */
+  if (!DataQueueIsSpsc(dq)) {
+    return;
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  if (!isWaitQueueEmpty(&dq->wait_get_queue)) {
+    thread = WaitQueueHead(&dq->wait_get_queue);
+    winfo = &thread->winfo.dataque;
+    num = DataSpscGet(dq, (uint8_t *)winfo->data_ptr, winfo->count);
+    if (num != 0U) {
+      libThreadWaitExit(thread, num, DISPATCH_NO);
+    }
+  }
+
+  if (!isWaitQueueEmpty(&dq->wait_put_queue)) {
+    thread = WaitQueueHead(&dq->wait_put_queue);
+    winfo = &thread->winfo.dataque;
+    num = DataSpscPut(dq, (const uint8_t *)winfo->data_ptr, winfo->count);
+    if (num != 0U) {
+      libThreadWaitExit(thread, num, DISPATCH_NO);
+    }
+  }
+
+  libThreadDispatch(NULL);
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Wake the Thread blocked on the other side of a single producer / single consumer ring.
+ * @param[in]   dq  data queue object.
+ */
+static void DataQueueSpscNotify(osDataQueue_t *dq)
+{
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (IsIrqDeferred()) {
+      libIsrQueuePut(DataQueueSpscPostProcess, dq);
+    }
+    else {
+      DataQueueSpscPostProcess(dq);
+    }
+  }
+  else {
+    (void)svc_1((uint32_t)dq, (uint32_t)DataQueueSpscPostProcess);
+  }
+}
+
+static uint32_t DataQueueSpscPutWait(osDataQueue_t *dq, const void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osThread_t *thread;
+  uint32_t    num;
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Consumer may have made space meanwhile */
+  num = DataSpscPut(dq, data_ptr, count);
+  if (num == 0U) {
+    /* Suspend current Thread */
+    thread = ThreadGetRunning();
+    if (libThreadWaitEnter(thread, &dq->wait_put_queue, timeout)) {
+      thread->winfo.dataque.data_ptr = (uint32_t)data_ptr;
+      thread->winfo.dataque.count    = count;
+      num = (uint32_t)osThreadWait;
+    }
+    else {
+      num = (uint32_t)osErrorTimeout;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (num);
+}
+
+static uint32_t DataQueueSpscGetWait(osDataQueue_t *dq, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osThread_t *thread;
+  uint32_t    num;
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Producer may have written data meanwhile */
+  num = DataSpscGet(dq, data_ptr, count);
+  if (num == 0U) {
+    /* Suspend current Thread */
+    thread = ThreadGetRunning();
+    if (libThreadWaitEnter(thread, &dq->wait_get_queue, timeout)) {
+      thread->winfo.dataque.data_ptr = (uint32_t)data_ptr;
+      thread->winfo.dataque.count    = count;
+      num = (uint32_t)osThreadWait;
+    }
+    else {
+      num = (uint32_t)osErrorTimeout;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (num);
+}
+
+/**
+ * @brief       Put Data into a single producer / single consumer ring (runs in caller context).
+ * @param[in]   dq        data queue object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   count     number of data in the buffer.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data put or a negative status code.
+ */
+static uint32_t DataQueueSpscPut(osDataQueue_t *dq, const void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  uint32_t num;
+
+  if ((data_ptr == NULL) || (count == 0U)) {
+    return ((uint32_t)osErrorParameter);
+  }
+
+  num = DataSpscPut(dq, data_ptr, count);
+  if (num != 0U) {
+    /* Consumer is blocked only when the ring was empty */
+    if (*(volatile uint32_t *)&dq->wait_get_queue.bmp != 0U) {
+      DataQueueSpscNotify(dq);
+    }
+  }
+  else if (timeout == 0U) {
+    num = (uint32_t)osErrorResource;
+  }
+  else if (IsIrqMode() || IsIrqMasked()) {
+    num = (uint32_t)osErrorParameter;
+  }
+  else {
+    num = svc_4((uint32_t)dq, (uint32_t)data_ptr, count, timeout, (uint32_t)DataQueueSpscPutWait);
+    if ((int32_t)num == osThreadWait) {
+      num = ThreadGetRunning()->winfo.ret_val;
+    }
+  }
+
+  return (num);
+}
+
+/**
+ * @brief       Get Data from a single producer / single consumer ring (runs in caller context).
+ * @param[in]   dq        data queue object.
+ * @param[out]  data_ptr  pointer to buffer for data.
+ * @param[in]   count     number of data the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data got or a negative status code.
+ */
+static uint32_t DataQueueSpscGet(osDataQueue_t *dq, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  uint32_t num;
+
+  if ((data_ptr == NULL) || (count == 0U)) {
+    return ((uint32_t)osErrorParameter);
+  }
+
+  num = DataSpscGet(dq, data_ptr, count);
+  if (num != 0U) {
+    /* Producer is blocked only when the ring was full */
+    if (*(volatile uint32_t *)&dq->wait_put_queue.bmp != 0U) {
+      DataQueueSpscNotify(dq);
+    }
+  }
+  else if (timeout == 0U) {
+    num = (uint32_t)osErrorResource;
+  }
+  else if (IsIrqMode() || IsIrqMasked()) {
+    num = (uint32_t)osErrorParameter;
+  }
+  else {
+    num = svc_4((uint32_t)dq, (uint32_t)data_ptr, count, timeout, (uint32_t)DataQueueSpscGetWait);
+    if ((int32_t)num == osThreadWait) {
+      num = ThreadGetRunning()->winfo.ret_val;
+    }
+  }
+
+  return (num);
+}
+
 static osDataQueueId_t DataQueueNew(uint32_t data_count, uint32_t data_size, const osDataQueueAttr_t *attr)
 {
   osDataQueue_t *dq;
   void          *dq_mem;
+  uint32_t       dq_size;
   uint32_t       data_limit;
+  const char    *name;
+  uint8_t        flags;
+  uint8_t        attr_bits;
 
   /* Check parameters */
-  if ((data_count == 0U) || (data_size  == 0U) || (attr == NULL)) {
+  if ((data_count == 0U) || (data_size  == 0U) || ((__CLZ(data_count) + __CLZ(data_size)) < 32U)) {
     return (NULL);
   }
 
-  dq         = attr->cb_mem;
-  dq_mem     = attr->dq_mem;
   data_limit = data_count * data_size;
 
-  /* Check parameters */
-  if (((__CLZ(data_count) + __CLZ(data_size)) < 32U) ||
-      (dq == NULL) || (((uint32_t)dq & 3U) != 0U) || (attr->cb_size < sizeof(osDataQueue_t)) ||
-      (dq_mem == NULL) || (attr->dq_size < data_limit)) {
-    return (NULL);
+  if (attr != NULL) {
+    name      = attr->name;
+    attr_bits = (uint8_t)(attr->attr_bits & osDataQueueSpsc);
+    dq        = attr->cb_mem;
+    dq_mem    = attr->dq_mem;
+    dq_size   = attr->dq_size;
+    /* Check parameters */
+    if (((dq != NULL) && ((((uint32_t)dq & 3U) != 0U) || (attr->cb_size < sizeof(osDataQueue_t)))) ||
+        ((dq_mem != NULL) && (dq_size < data_limit))) {
+      return (NULL);
+    }
+    /* Single producer / single consumer ring requires power of 2 capacity */
+    if (((attr_bits & osDataQueueSpsc) != 0U) && ((data_count & (data_count - 1U)) != 0U)) {
+      return (NULL);
+    }
+  }
+  else {
+    name      = NULL;
+    attr_bits = 0U;
+    dq        = NULL;
+    dq_mem    = NULL;
+  }
+
+  flags = 0U;
+
+  /* Allocate control block and data storage from the Object Memory Pools */
+  if (dq == NULL) {
+    dq = libObjectAlloc(osObjectPoolDataQueue, sizeof(osDataQueue_t));
+    if (dq == NULL) {
+      return (NULL);
+    }
+    flags |= osFlagSystemObject;
+  }
+
+  if (dq_mem == NULL) {
+    dq_mem = libObjectAlloc(osObjectPoolDataQueueData, data_limit);
+    if (dq_mem == NULL) {
+      if ((flags & osFlagSystemObject) != 0U) {
+        libObjectFree(osObjectPoolDataQueue, dq);
+      }
+      return (NULL);
+    }
+    flags |= osFlagSystemMemory;
   }
 
   /* Initialize control block */
   dq->id             = ID_DATA_QUEUE;
-  dq->flags          = 0U;
-  dq->name           = attr->name;
+  dq->flags          = flags;
+  dq->attr           = attr_bits;
+  dq->name           = name;
   dq->max_data_count = data_count;
   dq->data_size      = data_size;
   dq->data_count     = 0U;
@@ -126,8 +595,8 @@ static osDataQueueId_t DataQueueNew(uint32_t data_count, uint32_t data_size, con
   dq->tail           = 0U;
   dq->dq_mem         = dq_mem;
 
-  QueueReset(&dq->wait_put_queue);
-  QueueReset(&dq->wait_get_queue);
+  WaitQueueReset(&dq->wait_put_queue);
+  WaitQueueReset(&dq->wait_get_queue);
 
   return (dq);
 }
@@ -158,11 +627,10 @@ static osStatus_t DataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, uint
   BEGIN_CRITICAL_SECTION
 
   /* Check if Thread is waiting to receive a data */
-  if (!isQueueEmpty(&dq->wait_get_queue)) {
+  if (!isWaitQueueEmpty(&dq->wait_get_queue)) {
     /* Wakeup waiting Thread with highest Priority */
-    thread = GetThreadByQueue(dq->wait_get_queue.next);
-    libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
-    memcpy((void *)thread->winfo.dataque.data_ptr, data_ptr, dq->data_size);
+    (void)DataQueueWakeupGet(dq, data_ptr, 1U);
+    libThreadDispatch(NULL);
     status = osOK;
   }
   else {
@@ -177,6 +645,7 @@ static osStatus_t DataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, uint
         thread = ThreadGetRunning();
         if (libThreadWaitEnter(thread, &dq->wait_put_queue, timeout)) {
           thread->winfo.dataque.data_ptr = (uint32_t)data_ptr;
+          thread->winfo.dataque.count    = 0U;
           status = (osStatus_t)osThreadWait;
         }
         else {
@@ -210,14 +679,9 @@ static osStatus_t DataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t t
   /* Get Data from Queue */
   if (DataGet(dq, data_ptr) != false) {
     /* Check if Thread is waiting to send a data */
-    if (!isQueueEmpty(&dq->wait_put_queue)) {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(dq->wait_put_queue.next);
-      /* Try to put a data into Queue */
-      if (DataPut(dq, (const void *)thread->winfo.dataque.data_ptr) != false) {
-        /* Wakeup waiting Thread with highest Priority */
-        libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
-      }
+    if (!isWaitQueueEmpty(&dq->wait_put_queue)) {
+      DataQueueWakeupPut(dq);
+      libThreadDispatch(NULL);
     }
     status = osOK;
   }
@@ -228,6 +692,7 @@ static osStatus_t DataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t t
       thread = ThreadGetRunning();
       if (libThreadWaitEnter(thread, &dq->wait_get_queue, timeout)) {
         thread->winfo.dataque.data_ptr = (uint32_t)data_ptr;
+        thread->winfo.dataque.count    = 0U;
         status = (osStatus_t)osThreadWait;
       }
       else {
@@ -244,6 +709,85 @@ static osStatus_t DataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t t
   return (status);
 }
 
+static uint32_t DataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osDataQueue_t    *dq = dq_id;
+  osThread_t       *thread;
+  uint32_t          num;
+
+  /* Check parameters */
+  if ((dq == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL) || (count == 0U)) {
+    return (0U);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  num = 0U;
+
+  /* Check if Threads are waiting to receive a data */
+  if (!isWaitQueueEmpty(&dq->wait_get_queue)) {
+    num = DataQueueWakeupGet(dq, data_ptr, count);
+    libThreadDispatch(NULL);
+  }
+
+  /* Put the rest of data into Queue */
+  num += DataPutN(dq, &((const uint8_t *)data_ptr)[num * dq->data_size], count - num);
+
+  if ((num == 0U) && (timeout != 0U)) {
+    /* Suspend current Thread */
+    thread = ThreadGetRunning();
+    if (libThreadWaitEnter(thread, &dq->wait_put_queue, timeout)) {
+      thread->winfo.dataque.data_ptr = (uint32_t)data_ptr;
+      thread->winfo.dataque.count    = count;
+      num = (uint32_t)osThreadWait;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (num);
+}
+
+static uint32_t DataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  osDataQueue_t    *dq = dq_id;
+  osThread_t       *thread;
+  uint32_t          num;
+
+  /* Check parameters */
+  if ((dq == NULL) || (dq->id != ID_DATA_QUEUE) || (data_ptr == NULL) || (count == 0U)) {
+    return (0U);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Get data from Queue */
+  num = DataGetN(dq, data_ptr, count);
+
+  if (num != 0U) {
+    /* Check if Threads are waiting to send a data */
+    if (!isWaitQueueEmpty(&dq->wait_put_queue)) {
+      DataQueueWakeupPut(dq);
+      libThreadDispatch(NULL);
+    }
+  }
+  else {
+    if (timeout != 0U) {
+      /* Suspend current Thread */
+      thread = ThreadGetRunning();
+      if (libThreadWaitEnter(thread, &dq->wait_get_queue, timeout)) {
+        thread->winfo.dataque.data_ptr = (uint32_t)data_ptr;
+        thread->winfo.dataque.count    = count;
+        num = (uint32_t)osThreadWait;
+      }
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (num);
+}
+
 static uint32_t DataQueueGetCapacity(osDataQueueId_t dq_id)
 {
   osDataQueue_t *dq = dq_id;
@@ -277,6 +821,10 @@ static uint32_t DataQueueGetCount(osDataQueueId_t dq_id)
     return (0U);
   }
 
+  if ((dq->attr & osDataQueueSpsc) != 0U) {
+    return (*(volatile uint32_t *)&dq->head - *(volatile uint32_t *)&dq->tail);
+  }
+
   return (dq->data_count);
 }
 
@@ -289,14 +837,16 @@ static uint32_t DataQueueGetSpace(osDataQueueId_t dq_id)
     return (0U);
   }
 
+  if ((dq->attr & osDataQueueSpsc) != 0U) {
+    return (dq->max_data_count - (*(volatile uint32_t *)&dq->head - *(volatile uint32_t *)&dq->tail));
+  }
+
   return (dq->max_data_count - dq->data_count);
 }
 
 static osStatus_t DataQueueReset(osDataQueueId_t dq_id)
 {
   osDataQueue_t    *dq = dq_id;
-  osThread_t       *thread;
-  winfo_dataque_t  *winfo;
 
   /* Check parameters */
   if ((dq == NULL) || (dq->id != ID_DATA_QUEUE)) {
@@ -305,25 +855,26 @@ static osStatus_t DataQueueReset(osDataQueueId_t dq_id)
 
   BEGIN_CRITICAL_SECTION
 
-  /* Remove data from Queue */
-  dq->data_count = 0U;
-  dq->head       = 0U;
-  dq->tail       = 0U;
+  if ((dq->attr & osDataQueueSpsc) != 0U) {
+    /* Discard data on behalf of the consumer, head is owned by the producer */
+    dq->tail = dq->head;
+  }
+  else {
+    /* Remove data from Queue */
+    dq->data_count = 0U;
+    dq->head       = 0U;
+    dq->tail       = 0U;
+  }
 
   /* Check if Threads are waiting to send a data */
-  if (!isQueueEmpty(&dq->wait_put_queue)) {
-    do {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(dq->wait_put_queue.next);
-      winfo = &thread->winfo.dataque;
-      /* Try to put a data into Queue */
-      if (DataPut(dq, (const void *)winfo->data_ptr) == false) {
-        break;
-      }
-      /* Wakeup waiting Thread with highest Priority */
-      libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
-    } while(!isQueueEmpty(&dq->wait_put_queue));
-    libThreadDispatch(NULL);
+  if (!isWaitQueueEmpty(&dq->wait_put_queue)) {
+    if ((dq->attr & osDataQueueSpsc) != 0U) {
+      DataQueueSpscPostProcess(dq);
+    }
+    else {
+      DataQueueWakeupPut(dq);
+      libThreadDispatch(NULL);
+    }
   }
 
   END_CRITICAL_SECTION
@@ -347,6 +898,14 @@ static osStatus_t DataQueueDelete(osDataQueueId_t dq_id)
   /* Mark object as invalid */
   dq->id = ID_INVALID;
 
+  /* Free object memory */
+  if ((dq->flags & osFlagSystemMemory) != 0U) {
+    libObjectFree(osObjectPoolDataQueueData, dq->dq_mem);
+  }
+  if ((dq->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolDataQueue, dq);
+  }
+
   return (osOK);
 }
 
@@ -408,11 +967,18 @@ osStatus_t osDataQueuePut(osDataQueueId_t dq_id, const void *data_ptr, uint32_t
 {
   osStatus_t status;
 
-  if (IsIrqMode() || IsIrqMasked()) {
+  if (DataQueueIsSpsc(dq_id)) {
+    status = (osStatus_t)DataQueueSpscPut(dq_id, data_ptr, 1U, timeout);
+    if ((int32_t)status > 0) {
+      status = osOK;
+    }
+  }
+  else if (IsIrqMode() || IsIrqMasked()) {
     if (timeout != 0U) {
       status = osErrorParameter;
     }
     else {
+      TraceEvent(osTraceIsrCall, (uint32_t)DataQueuePut, (uint32_t)dq_id);
       status = DataQueuePut(dq_id, data_ptr, timeout);
     }
   }
@@ -438,11 +1004,18 @@ osStatus_t osDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeou
 {
   osStatus_t status;
 
-  if (IsIrqMode() || IsIrqMasked()) {
+  if (DataQueueIsSpsc(dq_id)) {
+    status = (osStatus_t)DataQueueSpscGet(dq_id, data_ptr, 1U, timeout);
+    if ((int32_t)status > 0) {
+      status = osOK;
+    }
+  }
+  else if (IsIrqMode() || IsIrqMasked()) {
     if (timeout != 0U) {
       status = osErrorParameter;
     }
     else {
+      TraceEvent(osTraceIsrCall, (uint32_t)DataQueueGet, (uint32_t)dq_id);
       status = DataQueueGet(dq_id, data_ptr, timeout);
     }
   }
@@ -456,6 +1029,88 @@ osStatus_t osDataQueueGet(osDataQueueId_t dq_id, void *data_ptr, uint32_t timeou
   return (status);
 }
 
+/**
+ * @fn          uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Put up to count Data into a Queue or timeout if Queue is full.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[in]   data_ptr  pointer to buffer with data to put into a queue.
+ * @param[in]   count     number of data in the buffer.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data put into the queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueuePutN(osDataQueueId_t dq_id, const void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  uint32_t num;
+
+  if (DataQueueIsSpsc(dq_id)) {
+    num = DataQueueSpscPut(dq_id, data_ptr, count, timeout);
+    if ((int32_t)num < 0) {
+      num = 0U;
+    }
+  }
+  else if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      num = 0U;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)DataQueuePutN, (uint32_t)dq_id);
+      num = DataQueuePutN(dq_id, data_ptr, count, timeout);
+    }
+  }
+  else {
+    num = svc_4((uint32_t)dq_id, (uint32_t)data_ptr, count, timeout, (uint32_t)DataQueuePutN);
+    if ((int32_t)num == osThreadWait) {
+      num = ThreadGetRunning()->winfo.ret_val;
+      if (((osStatus_t)num == osErrorTimeout) || ((osStatus_t)num == osErrorResource)) {
+        num = 0U;
+      }
+    }
+  }
+
+  return (num);
+}
+
+/**
+ * @fn          uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+ * @brief       Get up to count Data from a Queue or timeout if Queue is empty.
+ * @param[in]   dq_id     data queue ID obtained by \ref osDataQueueNew.
+ * @param[out]  data_ptr  pointer to buffer for data to get from a queue.
+ * @param[in]   count     number of data the buffer can hold.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of data got from the queue or 0 in case of an error or time-out.
+ */
+uint32_t osDataQueueGetN(osDataQueueId_t dq_id, void *data_ptr, uint32_t count, uint32_t timeout)
+{
+  uint32_t num;
+
+  if (DataQueueIsSpsc(dq_id)) {
+    num = DataQueueSpscGet(dq_id, data_ptr, count, timeout);
+    if ((int32_t)num < 0) {
+      num = 0U;
+    }
+  }
+  else if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      num = 0U;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)DataQueueGetN, (uint32_t)dq_id);
+      num = DataQueueGetN(dq_id, data_ptr, count, timeout);
+    }
+  }
+  else {
+    num = svc_4((uint32_t)dq_id, (uint32_t)data_ptr, count, timeout, (uint32_t)DataQueueGetN);
+    if ((int32_t)num == osThreadWait) {
+      num = ThreadGetRunning()->winfo.ret_val;
+      if (((osStatus_t)num == osErrorTimeout) || ((osStatus_t)num == osErrorResource)) {
+        num = 0U;
+      }
+    }
+  }
+
+  return (num);
+}
+
 /**
  * @fn          uint32_t osDataQueueGetCapacity(osDataQueueId_t dq_id)
  * @brief       Get maximum number of data in a Data Queue.
@@ -470,7 +1125,7 @@ uint32_t osDataQueueGetCapacity(osDataQueueId_t dq_id)
     capacity = DataQueueGetCapacity(dq_id);
   }
   else {
-    capacity = svc_1((uint32_t)dq_id, (uint32_t)DataQueueGetCapacity);
+    capacity = svc_read_1((uint32_t)dq_id, (uint32_t)DataQueueGetCapacity);
   }
 
   return (capacity);
@@ -490,7 +1145,7 @@ uint32_t osDataQueueGetDataSize(osDataQueueId_t dq_id)
     data_size = DataQueueGetMsgSize(dq_id);
   }
   else {
-    data_size = svc_1((uint32_t)dq_id, (uint32_t)DataQueueGetMsgSize);
+    data_size = svc_read_1((uint32_t)dq_id, (uint32_t)DataQueueGetMsgSize);
   }
 
   return (data_size);
@@ -510,7 +1165,7 @@ uint32_t osDataQueueGetCount(osDataQueueId_t dq_id)
     count = DataQueueGetCount(dq_id);
   }
   else {
-    count = svc_1((uint32_t)dq_id, (uint32_t)DataQueueGetCount);
+    count = svc_read_1((uint32_t)dq_id, (uint32_t)DataQueueGetCount);
   }
 
   return (count);
@@ -530,7 +1185,7 @@ uint32_t osDataQueueGetSpace(osDataQueueId_t dq_id)
     space = DataQueueGetSpace(dq_id);
   }
   else {
-    space = svc_1((uint32_t)dq_id, (uint32_t)DataQueueGetSpace);
+    space = svc_read_1((uint32_t)dq_id, (uint32_t)DataQueueGetSpace);
   }
 
   return (space);
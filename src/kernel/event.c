@@ -101,28 +101,74 @@ uint32_t FlagsCheck (osEventFlags_t *evf, uint32_t flags, uint32_t options)
   return pattern;
 }
 
+/**
+ * @brief       Add a waiting Thread to the tail of its wait list.
+ * @param[in]   evf       event flags object.
+ * @param[in]   thread    thread object.
+ * @note        A Thread waiting for all flags is listed under one of the missing
+ *              flags, a Thread waiting for any flag under the lowest of them.
+ *              The wait mask of a list holds the flags that can wake its Threads.
+ */
+static void EventFlagsWaitListAdd(osEventFlags_t *evf, osThread_t *thread)
+{
+  uint32_t flags = thread->winfo.event.flags;
+  uint32_t list;
+
+  if ((thread->winfo.event.options & osFlagsWaitAll) != 0U) {
+    list  = 31U - __CLZ(flags & ~evf->event_flags);
+    flags = 1UL << list;
+  }
+  else {
+    list  = 31U - __CLZ(flags & (0U - flags));
+  }
+
+  QueueAppend(&evf->wait_list[list], &thread->flags_que);
+
+  evf->wait_bmp |= (1UL << list);
+  evf->wait_mask[list] |= flags;
+}
+
 static osEventFlagsId_t EventFlagsNew(const osEventFlagsAttr_t *attr)
 {
   osEventFlags_t *evf;
-
-  /* Check parameters */
-  if ((attr == NULL)                        ||
-      (attr->cb_mem == NULL)                ||
-      (((uint32_t)attr->cb_mem & 3U) != 0U) ||
-      (attr->cb_size < sizeof(osEventFlags_t)))
-  {
-    return (NULL);
+  const char     *name;
+  uint8_t         flags;
+
+  if (attr != NULL) {
+    name = attr->name;
+    evf  = attr->cb_mem;
+    /* Check parameters */
+    if ((evf != NULL) && ((((uint32_t)evf & 3U) != 0U) || (attr->cb_size < sizeof(osEventFlags_t)))) {
+      return (NULL);
+    }
+  }
+  else {
+    name = NULL;
+    evf  = NULL;
   }
 
-  evf = attr->cb_mem;
+  flags = 0U;
+
+  /* Allocate control block from the Object Memory Pool */
+  if (evf == NULL) {
+    evf = libObjectAlloc(osObjectPoolEventFlags, sizeof(osEventFlags_t));
+    if (evf == NULL) {
+      return (NULL);
+    }
+    flags = osFlagSystemObject;
+  }
 
   /* Initialize control block */
   evf->id = ID_EVENT_FLAGS;
-  evf->flags = 0U;
-  evf->name = attr->name;
+  evf->flags = flags;
+  evf->name = name;
   evf->event_flags = 0U;
+  evf->wait_bmp = 0U;
 
-  QueueReset(&evf->wait_queue);
+  for (uint32_t i = 0U; i < osEventFlagsLimit; i++) {
+    evf->wait_mask[i] = 0U;
+    QueueReset(&evf->wait_list[i]);
+  }
 
   return (evf);
 }
@@ -139,12 +185,77 @@ static const char *EventFlagsGetName(osEventFlagsId_t ef_id)
   return (evf->name);
 }
 
+/**
+ * @brief       Wakeup Threads whose wait condition is met by the current Event Flags.
+ * @param[in]   evf   event flags object.
+ * @note        Only the lists whose wait mask matches the flags are visited. Their
+ *              Threads are sorted into per-priority buckets (FIFO within a priority),
+ *              checked in priority order and the ones still waiting are listed again.
+ */
+static void EventFlagsWakeup(osEventFlags_t *evf)
+{
+  queue_t    *bucket[osPriorityISR];
+  queue_t    *que;
+  queue_t    *entry;
+  queue_t    *prev;
+  osThread_t *thread;
+  uint32_t    prio_bmp;
+  uint32_t    prio;
+  uint32_t    bmp;
+  uint32_t    list;
+  uint32_t    pattern;
+
+  prio_bmp = 0U;
+
+  for (bmp = evf->wait_bmp; bmp != 0U; bmp &= ~(1UL << list)) {
+    list = 31U - __CLZ(bmp);
+    if ((evf->wait_mask[list] & evf->event_flags) == 0U) {
+      continue;
+    }
+
+    /* Take all Threads off the list, walk backwards to keep the FIFO order */
+    que = &evf->wait_list[list];
+    for (entry = que->prev; entry != que; entry = prev) {
+      prev = entry->prev;
+      prio = (uint32_t)GetThreadByFlagsQueue(entry)->priority - 1U;
+      if ((prio_bmp & (1UL << prio)) == 0U) {
+        prio_bmp |= (1UL << prio);
+        bucket[prio] = NULL;
+      }
+      entry->next = bucket[prio];
+      bucket[prio] = entry;
+    }
+    QueueReset(que);
+    evf->wait_bmp &= ~(1UL << list);
+    evf->wait_mask[list] = 0U;
+  }
+
+  /* Visit the Threads in priority order */
+  while (prio_bmp != 0U) {
+    prio = 31U - __CLZ(prio_bmp);
+    entry = bucket[prio];
+    bucket[prio] = entry->next;
+    if (bucket[prio] == NULL) {
+      prio_bmp &= ~(1UL << prio);
+    }
+
+    QueueReset(entry);
+    thread = GetThreadByFlagsQueue(entry);
+
+    pattern = FlagsCheck(evf, thread->winfo.event.flags, thread->winfo.event.options);
+    if (pattern != 0U) {
+      libThreadWaitExit(thread, pattern, DISPATCH_NO);
+    }
+    else {
+      EventFlagsWaitListAdd(evf, thread);
+    }
+  }
+}
+
 static uint32_t EventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
 {
   osEventFlags_t *evf = (osEventFlags_t *)ef_id;
-  uint32_t        event_flags, pattern;
-  queue_t        *que;
-  osThread_t     *thread;
+  uint32_t        event_flags;
 
   /* Check parameters */
   if ((evf == NULL) || (evf->id != ID_EVENT_FLAGS) ||
@@ -156,28 +267,62 @@ static uint32_t EventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
   BEGIN_CRITICAL_SECTION
 
   /* Set Event Flags */
-  event_flags = FlagsSet(evf, flags);
+  FlagsSet(evf, flags);
 
-  que = evf->wait_queue.next;
-  while (que != &evf->wait_queue) {
-    thread = GetThreadByQueue(que);
-    que = que->next;
+  /* Wakeup waiting Threads, they may clear the flags */
+  EventFlagsWakeup(evf);
+  event_flags = evf->event_flags;
 
-    pattern = FlagsCheck(evf, thread->winfo.event.flags, thread->winfo.event.options);
+  libThreadDispatch(NULL);
 
-    if (pattern) {
-      if (!(thread->winfo.event.options & osFlagsNoClear)) {
-        event_flags = pattern & ~thread->winfo.event.flags;
-      }
-      else {
-        event_flags = pattern;
-      }
-      libThreadWaitExit(thread, pattern, DISPATCH_NO);
-    }
+  END_CRITICAL_SECTION
+
+  return (event_flags);
+}
+
+/**
+ * @brief       Wakeup Threads waiting for Event Flags set from ISR (executed by PendSV).
+ * @param[in]   object  event flags object.
+ */
+static void EventFlagsPostProcess(void *object)
+{
+  osEventFlags_t *evf = object;
+
+  /* Check object state */
+  if (evf->id != ID_EVENT_FLAGS) {
+    return;
   }
+
+  BEGIN_CRITICAL_SECTION
+
+  EventFlagsWakeup(evf);
   libThreadDispatch(NULL);
 
   END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Set Event Flags from ISR and defer waking of waiting Threads.
+ * @param[in]   ef_id   event flags ID obtained by \ref osEventFlagsNew.
+ * @param[in]   flags   specifies the flags that shall be set.
+ * @return      event flags after setting or error code if highest bit set.
+ */
+static uint32_t isrEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
+{
+  osEventFlags_t *evf = (osEventFlags_t *)ef_id;
+  uint32_t        event_flags;
+
+  /* Check parameters */
+  if ((evf == NULL) || (evf->id != ID_EVENT_FLAGS) ||
+      (flags == 0U) || ((flags & (1UL << osEventFlagsLimit)) != 0U))
+  {
+    return ((uint32_t)osErrorParameter);
+  }
+
+  /* Set Event Flags */
+  event_flags = archAtomicSetBits(&evf->event_flags, flags);
+
+  libIsrQueuePut(EventFlagsPostProcess, evf);
 
   return (event_flags);
 }
@@ -237,10 +382,11 @@ static uint32_t EventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t
   if (event_flags == 0U) {
     if (timeout != 0U) {
       thread = ThreadGetRunning();
-      if (libThreadWaitEnter(thread, &evf->wait_queue, timeout)) {
+      if (libThreadWaitEnter(thread, NULL, timeout)) {
         winfo = &thread->winfo.event;
         winfo->options = options;
         winfo->flags = flags;
+        EventFlagsWaitListAdd(evf, thread);
         event_flags = (uint32_t)osThreadWait;
       }
       else {
@@ -267,11 +413,21 @@ static osStatus_t EventFlagsDelete(osEventFlagsId_t ef_id)
   }
 
   /* Unblock waiting threads */
-  libThreadWaitDelete(&evf->wait_queue);
+  for (uint32_t i = 0U; i < osEventFlagsLimit; i++) {
+    while (!isQueueEmpty(&evf->wait_list[i])) {
+      libThreadWaitExit(GetThreadByFlagsQueue(evf->wait_list[i].next), (uint32_t)osErrorResource, DISPATCH_NO);
+    }
+  }
+  libThreadDispatch(NULL);
 
   /* Mark object as invalid */
   evf->id = ID_INVALID;
 
+  /* Free object memory */
+  if ((evf->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolEventFlags, evf);
+  }
+
   return (osOK);
 }
 
@@ -331,7 +487,13 @@ uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
   uint32_t event_flags;
 
   if (IsIrqMode() || IsIrqMasked()) {
-    event_flags = EventFlagsSet(ef_id, flags);
+    TraceEvent(osTraceIsrCall, (uint32_t)EventFlagsSet, (uint32_t)ef_id);
+    if (IsIrqDeferred()) {
+      event_flags = isrEventFlagsSet(ef_id, flags);
+    }
+    else {
+      event_flags = EventFlagsSet(ef_id, flags);
+    }
   }
   else {
     event_flags = svc_2((uint32_t)ef_id, flags, (uint32_t)EventFlagsSet);
@@ -352,6 +514,7 @@ uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags)
   uint32_t event_flags;
 
   if (IsIrqMode() || IsIrqMasked()) {
+    TraceEvent(osTraceIsrCall, (uint32_t)EventFlagsClear, (uint32_t)ef_id);
     event_flags = EventFlagsClear(ef_id, flags);
   }
   else {
@@ -375,7 +538,7 @@ uint32_t osEventFlagsGet(osEventFlagsId_t ef_id)
     event_flags = EventFlagsGet(ef_id);
   }
   else {
-    event_flags = svc_1((uint32_t)ef_id, (uint32_t)EventFlagsGet);
+    event_flags = svc_read_1((uint32_t)ef_id, (uint32_t)EventFlagsGet);
   }
 
   return (event_flags);
@@ -0,0 +1,623 @@
+/*
+ * Copyright (C) 2019 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: uKernel real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Kernel system routines.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <string.h>
+#include "os_lib.h"
+
+/*******************************************************************************
+ *  external declarations
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+/* Two-Level Segregated Fit index */
+#define HEAP_ALIGN                  8U
+#define HEAP_SL_LOG2                3U                                        /* log2(osHeapSlCount) */
+#define HEAP_FL_SHIFT               (HEAP_SL_LOG2 + 3U)                       /* log2(osHeapSlCount * HEAP_ALIGN) */
+#define HEAP_SMALL_SIZE             (1U << HEAP_FL_SHIFT)                     /* Blocks below are kept in first level 0 */
+#define HEAP_BLOCK_MAX              (1U << (osHeapFlCount + HEAP_FL_SHIFT - 1U))
+
+/* Block layout */
+#define HEAP_HEADER_SIZE            ((uint32_t)offsetof(osHeapBlock_t, next_free))
+#define HEAP_BLOCK_MIN              ((uint32_t)sizeof(osHeapBlock_t) - HEAP_HEADER_SIZE)
+#define HEAP_BLOCK_FREE             0x01U
+
+#define BlockSize(block)            ((block)->size & ~(HEAP_ALIGN - 1U))
+#define BlockIsFree(block)          (((block)->size & HEAP_BLOCK_FREE) != 0U)
+#define BlockNext(block)            ((osHeapBlock_t *)((uint8_t *)(block) + HEAP_HEADER_SIZE + BlockSize(block)))
+#define BlockToPtr(block)           ((void *)((uint8_t *)(block) + HEAP_HEADER_SIZE))
+#define BlockFromPtr(ptr)           ((osHeapBlock_t *)((uint8_t *)(ptr) - HEAP_HEADER_SIZE))
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions  (scope: module-exported)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+/**
+ * @brief       Get index of the lowest set bit.
+ * @param[in]   bitmap  bitmap (not 0).
+ * @return      bit index.
+ */
+static
+uint32_t HeapLowestBit(uint32_t bitmap)
+{
+  return (31U - __CLZ(bitmap & (0U - bitmap)));
+}
+
+/**
+ * @brief       Get index of the highest set bit.
+ * @param[in]   bitmap  bitmap (not 0).
+ * @return      bit index.
+ */
+static
+uint32_t HeapHighestBit(uint32_t bitmap)
+{
+  return (31U - __CLZ(bitmap));
+}
+
+/**
+ * @brief       Map a block size to the free list holding blocks of this size.
+ * @param[in]   size  block size in bytes.
+ * @param[out]  fl    first level index.
+ * @param[out]  sl    second level index.
+ */
+static void HeapMapping(uint32_t size, uint32_t *fl, uint32_t *sl)
+{
+  uint32_t t;
+
+  if (size < HEAP_SMALL_SIZE) {
+    *fl = 0U;
+    *sl = size / (HEAP_SMALL_SIZE / osHeapSlCount);
+  }
+  else {
+    t = HeapHighestBit(size);
+    *sl = (size >> (t - HEAP_SL_LOG2)) ^ osHeapSlCount;
+    *fl = t - (HEAP_FL_SHIFT - 1U);
+  }
+}
+
+/**
+ * @brief       Insert a block into its free list.
+ * @param[in]   heap    heap control block.
+ * @param[in]   block   block not marked as free.
+ */
+static void HeapInsert(osHeap_t *heap, osHeapBlock_t *block)
+{
+  osHeapBlock_t *head;
+  uint32_t       fl;
+  uint32_t       sl;
+
+  HeapMapping(BlockSize(block), &fl, &sl);
+
+  head = heap->blocks[fl][sl];
+  block->next_free = head;
+  block->prev_free = NULL;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+  heap->blocks[fl][sl] = block;
+  heap->fl_bitmap     |= (1UL << fl);
+  heap->sl_bitmap[fl] |= (1UL << sl);
+
+  block->size |= HEAP_BLOCK_FREE;
+  heap->free_size += BlockSize(block);
+  heap->free_blocks++;
+}
+
+/**
+ * @brief       Remove a block from its free list.
+ * @param[in]   heap    heap control block.
+ * @param[in]   block   free block.
+ */
+static void HeapRemove(osHeap_t *heap, osHeapBlock_t *block)
+{
+  uint32_t fl;
+  uint32_t sl;
+
+  HeapMapping(BlockSize(block), &fl, &sl);
+
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  }
+  else {
+    heap->blocks[fl][sl] = block->next_free;
+    if (block->next_free == NULL) {
+      heap->sl_bitmap[fl] &= ~(1UL << sl);
+      if (heap->sl_bitmap[fl] == 0U) {
+        heap->fl_bitmap &= ~(1UL << fl);
+      }
+    }
+  }
+
+  block->size &= ~HEAP_BLOCK_FREE;
+  heap->free_size -= BlockSize(block);
+  heap->free_blocks--;
+}
+
+/**
+ * @brief       Get the block size used for a request.
+ * @param[in]   size    requested size in bytes (less than HEAP_BLOCK_MAX).
+ * @return      aligned block size.
+ */
+static uint32_t HeapBlockSize(uint32_t size)
+{
+  size = (size + (HEAP_ALIGN - 1U)) & ~(HEAP_ALIGN - 1U);
+  if (size < HEAP_BLOCK_MIN) {
+    size = HEAP_BLOCK_MIN;
+  }
+
+  return (size);
+}
+
+/**
+ * @brief       Check that a block header belongs to an allocated block of the heap.
+ * @param[in]   heap    heap control block.
+ * @param[in]   block   block inside the heap area.
+ * @return      true - allocated block, false - free block or stale header.
+ * @note        Both physical neighbours must link back to the block, so a header
+ *              absorbed by a merge is rejected.
+ */
+static bool HeapBlockIsUsed(const osHeap_t *heap, const osHeapBlock_t *block)
+{
+  const osHeapBlock_t *prev = block->prev_phys;
+  const osHeapBlock_t *next;
+
+  if (BlockIsFree(block) || (BlockSize(block) > heap->size)) {
+    return (false);
+  }
+
+  if (prev == NULL) {
+    if (block != heap->base) {
+      return (false);
+    }
+  }
+  else if ((prev < heap->base) || (prev >= block) || (BlockNext(prev) != block)) {
+    return (false);
+  }
+
+  next = BlockNext(block);
+
+  return ((next <= heap->limit) && (next->prev_phys == block));
+}
+
+/**
+ * @brief       Allocate a block in bounded time (good fit).
+ * @param[in]   heap    heap control block.
+ * @param[in]   size    requested size in bytes.
+ * @return      address of the allocated memory or NULL in case of no suitable block is free.
+ */
+static void *HeapBlockAlloc(osHeap_t *heap, uint32_t size)
+{
+  osHeapBlock_t *block;
+  osHeapBlock_t *remain;
+  uint32_t       search;
+  uint32_t       sl_map;
+  uint32_t       fl_map;
+  uint32_t       fl;
+  uint32_t       sl;
+
+  if ((size == 0U) || (size >= HEAP_BLOCK_MAX)) {
+    return (NULL);
+  }
+
+  size = HeapBlockSize(size);
+
+  /* Round up to the next list, so that any block found there fits */
+  search = size;
+  if (search >= HEAP_SMALL_SIZE) {
+    search += (1UL << (HeapHighestBit(search) - HEAP_SL_LOG2)) - 1U;
+  }
+  HeapMapping(search, &fl, &sl);
+
+  block = NULL;
+  if (fl < osHeapFlCount) {
+    sl_map = heap->sl_bitmap[fl] & (0xFFFFFFFFU << sl);
+    if (sl_map == 0U) {
+      fl_map = heap->fl_bitmap & (0xFFFFFFFEU << fl);
+      if (fl_map != 0U) {
+        fl = HeapLowestBit(fl_map);
+        sl_map = heap->sl_bitmap[fl];
+      }
+    }
+    if (sl_map != 0U) {
+      block = heap->blocks[fl][HeapLowestBit(sl_map)];
+    }
+  }
+
+  if (block == NULL) {
+    /* The head of the list of the requested size may still be large enough */
+    HeapMapping(size, &fl, &sl);
+    block = heap->blocks[fl][sl];
+    if ((block == NULL) || (BlockSize(block) < size)) {
+      return (NULL);
+    }
+  }
+
+  HeapRemove(heap, block);
+
+  /* Split off the remainder if it can hold a free block */
+  if ((BlockSize(block) - size) >= (uint32_t)sizeof(osHeapBlock_t)) {
+    remain = (osHeapBlock_t *)((uint8_t *)BlockToPtr(block) + size);
+    remain->prev_phys = block;
+    remain->size      = BlockSize(block) - size - HEAP_HEADER_SIZE;
+    block->size       = size;
+    BlockNext(remain)->prev_phys = remain;
+    HeapInsert(heap, remain);
+  }
+
+  heap->used_blocks++;
+  if (heap->free_size < heap->min_free_size) {
+    heap->min_free_size = heap->free_size;
+  }
+
+  return (BlockToPtr(block));
+}
+
+/**
+ * @brief       Release a block and merge it with free neighbours.
+ * @param[in]   heap    heap control block.
+ * @param[in]   block   allocated block.
+ */
+static void HeapBlockFree(osHeap_t *heap, osHeapBlock_t *block)
+{
+  osHeapBlock_t *next;
+  osHeapBlock_t *prev;
+
+  heap->used_blocks--;
+
+  next = BlockNext(block);
+  if (BlockIsFree(next)) {
+    HeapRemove(heap, next);
+    block->size += HEAP_HEADER_SIZE + BlockSize(next);
+    BlockNext(block)->prev_phys = block;
+  }
+
+  prev = block->prev_phys;
+  if ((prev != NULL) && BlockIsFree(prev)) {
+    HeapRemove(heap, prev);
+    prev->size += HEAP_HEADER_SIZE + BlockSize(block);
+    BlockNext(prev)->prev_phys = prev;
+    block = prev;
+  }
+
+  HeapInsert(heap, block);
+}
+
+/**
+ * @brief       Serve Threads waiting for memory in priority order.
+ * @param[in]   heap    heap control block.
+ * @note        A waiter whose request does not fit blocks the waiters behind it,
+ *              so smaller requests never starve a larger one. Only requests that
+ *              fit into the empty heap are queued, and the queue is dispatched
+ *              again when the head waiter leaves on timeout or termination.
+ */
+static void HeapDispatch(osHeap_t *heap)
+{
+  osThread_t *thread;
+  void       *ptr;
+
+  while (!isWaitQueueEmpty(&heap->wait_queue)) {
+    /* Get waiting Thread with highest Priority */
+    thread = WaitQueueHead(&heap->wait_queue);
+    ptr = HeapBlockAlloc(heap, thread->winfo.heap.size);
+    if (ptr == NULL) {
+      break;
+    }
+    libThreadWaitExit(thread, (uint32_t)ptr, DISPATCH_NO);
+  }
+}
+
+static void *HeapAlloc(uint32_t size, uint32_t timeout)
+{
+  osHeap_t *heap = osConfig.heap.cb;
+  void     *ptr;
+
+  /* Check parameters */
+  if ((heap == NULL) || (size == 0U)) {
+    return (NULL);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Do not overtake blocked Threads */
+  if (isWaitQueueEmpty(&heap->wait_queue)) {
+    ptr = HeapBlockAlloc(heap, size);
+  }
+  else {
+    ptr = NULL;
+  }
+
+  if (ptr == NULL) {
+    heap->fail_count++;
+    /* Wait only for requests the empty heap can satisfy */
+    if ((timeout != 0U) && (size < HEAP_BLOCK_MAX) && (HeapBlockSize(size) <= heap->size)) {
+      if (libThreadWaitEnter(ThreadGetRunning(), &heap->wait_queue, timeout)) {
+        ThreadGetRunning()->winfo.heap.size = size;
+        ptr = (void *)osThreadWait;
+      }
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (ptr);
+}
+
+static osStatus_t HeapFree(void *ptr)
+{
+  osHeap_t      *heap = osConfig.heap.cb;
+  osHeapBlock_t *block;
+  osStatus_t     status;
+
+  /* Check parameters */
+  if ((heap == NULL) || (heap->base == NULL) || (((uint32_t)ptr & (HEAP_ALIGN - 1U)) != 0U) ||
+      (ptr < BlockToPtr(heap->base)) || (ptr >= (void *)heap->limit)) {
+    return (osErrorParameter);
+  }
+
+  block = BlockFromPtr(ptr);
+
+  BEGIN_CRITICAL_SECTION
+
+  if (!HeapBlockIsUsed(heap, block)) {
+    /* Block is already free or the address is not a block */
+    status = osErrorResource;
+  }
+  else {
+    HeapBlockFree(heap, block);
+
+    /* Check if Threads are waiting for memory */
+    if (!isWaitQueueEmpty(&heap->wait_queue)) {
+      HeapDispatch(heap);
+      libThreadDispatch(NULL);
+    }
+    status = osOK;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (status);
+}
+
+static osStatus_t HeapGetStats(osHeapStats_t *stats)
+{
+  const osHeap_t      *heap = osConfig.heap.cb;
+  const osHeapBlock_t *block;
+  uint32_t             largest;
+  uint32_t             fl;
+  uint32_t             sl;
+
+  /* Check parameters */
+  if (stats == NULL) {
+    return (osErrorParameter);
+  }
+
+  if (heap == NULL) {
+    memset(stats, 0, sizeof(osHeapStats_t));
+    return (osOK);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* The largest free block is in the highest non-empty list */
+  largest = 0U;
+  if (heap->fl_bitmap != 0U) {
+    fl = HeapHighestBit(heap->fl_bitmap);
+    sl = HeapHighestBit(heap->sl_bitmap[fl]);
+    for (block = heap->blocks[fl][sl]; block != NULL; block = block->next_free) {
+      if (BlockSize(block) > largest) {
+        largest = BlockSize(block);
+      }
+    }
+  }
+
+  stats->total_size    = heap->size;
+  stats->free_size     = heap->free_size;
+  stats->min_free_size = heap->min_free_size;
+  stats->largest_free  = largest;
+  stats->used_blocks   = heap->used_blocks;
+  stats->free_blocks   = heap->free_blocks;
+  stats->fail_count    = heap->fail_count;
+
+  END_CRITICAL_SECTION
+
+  if (stats->free_size != 0U) {
+    stats->fragmentation = 100U - (uint32_t)(((uint64_t)largest * 100U) / stats->free_size);
+  }
+  else {
+    stats->fragmentation = 0U;
+  }
+
+  return (osOK);
+}
+
+/*******************************************************************************
+ *  Library functions
+ ******************************************************************************/
+
+/**
+ * @brief       Initialize the kernel Heap.
+ */
+void libHeapInit(void)
+{
+  osHeap_t      *heap = osConfig.heap.cb;
+  osHeapBlock_t *block;
+  osHeapBlock_t *sentinel;
+  uint32_t       size;
+
+  if (heap == NULL) {
+    return;
+  }
+
+  memset(heap, 0, sizeof(osHeap_t));
+  WaitQueueReset(&heap->wait_queue);
+
+  /* One free block followed by a sentinel header that is never free */
+  size = osConfig.heap.size & ~(HEAP_ALIGN - 1U);
+  if (size < (2U * HEAP_HEADER_SIZE + HEAP_BLOCK_MIN)) {
+    return;
+  }
+  size -= 2U * HEAP_HEADER_SIZE;
+  if (size >= HEAP_BLOCK_MAX) {
+    size = HEAP_BLOCK_MAX - HEAP_ALIGN;
+  }
+
+  block = osConfig.heap.mem;
+  block->prev_phys = NULL;
+  block->size      = size;
+
+  sentinel = BlockNext(block);
+  sentinel->prev_phys = block;
+  sentinel->size      = 0U;
+
+  heap->base  = block;
+  heap->limit = sentinel;
+  heap->size  = size;
+
+  HeapInsert(heap, block);
+  heap->min_free_size = heap->free_size;
+}
+
+/**
+ * @brief       Serve the remaining heap waiters after a Thread stopped waiting.
+ * @note        Called when the waiting Thread leaves on timeout, resume or termination.
+ */
+void libHeapWaitAbort(void)
+{
+  osHeap_t *heap = osConfig.heap.cb;
+
+  BEGIN_CRITICAL_SECTION
+
+  HeapDispatch(heap);
+
+  END_CRITICAL_SECTION
+}
+
+/*******************************************************************************
+ *  Public API
+ ******************************************************************************/
+
+/**
+ * @fn          void *osHeapAlloc(uint32_t size, uint32_t timeout)
+ * @brief       Allocate a memory block of arbitrary size from the kernel Heap.
+ * @param[in]   size      requested size in bytes.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ * @note        Waiting Threads are served in priority order and a request does not
+ *              overtake a waiting one. Requests larger than the heap fail at once.
+ */
+void *osHeapAlloc(uint32_t size, uint32_t timeout)
+{
+  void *memory;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      memory = NULL;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)HeapAlloc, size);
+      memory = HeapAlloc(size, timeout);
+    }
+  }
+  else {
+    memory = (void *)svc_2(size, timeout, (uint32_t)HeapAlloc);
+    if ((int32_t)memory == osThreadWait) {
+      memory = (void *)ThreadGetRunning()->winfo.ret_val;
+      if ((osStatus_t)memory == osErrorTimeout) {
+        memory = NULL;
+      }
+    }
+  }
+
+  return (memory);
+}
+
+/**
+ * @fn          osStatus_t osHeapFree(void *block)
+ * @brief       Return a memory block allocated by \ref osHeapAlloc.
+ * @param[in]   block   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapFree(void *block)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    TraceEvent(osTraceIsrCall, (uint32_t)HeapFree, (uint32_t)block);
+    status = HeapFree(block);
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)block, (uint32_t)HeapFree);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osHeapGetStats(osHeapStats_t *stats)
+ * @brief       Get usage and fragmentation statistics of the kernel Heap.
+ * @param[out]  stats   pointer to buffer for statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osHeapGetStats(osHeapStats_t *stats)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = HeapGetStats(stats);
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)stats, (uint32_t)HeapGetStats);
+  }
+
+  return (status);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
@@ -59,34 +59,37 @@
  *  function implementations (scope: module-local)
  ******************************************************************************/
 
-void osTick_Handler(void)
+/**
+ * @brief       Process expired Timers and Thread Delays.
+ */
+static void KernelTickProcess(void)
 {
-  osTimer_t *timer;
-  queue_t   *timer_queue;
-
-  ++osInfo.kernel.tick;
-
-  /* Process Timers */
-  if (osInfo.timer_semaphore != NULL) {
-    timer_queue = &osInfo.timer_queue;
-    if (!isQueueEmpty(timer_queue)) {
-      timer = GetTimerByQueue(timer_queue->next);
-      if (time_before_eq(timer->time, osInfo.kernel.tick)) {
-        osSemaphoreRelease(osInfo.timer_semaphore);
-      }
-    }
-  }
-
   BEGIN_CRITICAL_SECTION
 
-  /* Process Thread Delays */
-  if (libThreadDelayTick() == true) {
+  /* Process Timing Wheel */
+  if (libTimeoutTick() == true) {
     libThreadDispatch(NULL);
   }
 
   END_CRITICAL_SECTION
 }
 
+void osTick_Handler(void)
+{
+  ++osInfo.kernel.tick;
+
+  /* Keep the runtime accounting ahead of the cycle counter wrap-around */
+  libThreadRuntimeUpdate();
+
+  KernelTickProcess();
+
+  /* Process Round-Robin Thread switching (also for per-thread time slices
+     when the default Round-Robin Timeout is disabled) */
+  BEGIN_CRITICAL_SECTION
+  libThreadRobinTick();
+  END_CRITICAL_SECTION
+}
+
 static osStatus_t KernelInitialize(void)
 {
   if (osInfo.kernel.state == osKernelReady) {
@@ -100,12 +103,17 @@ static osStatus_t KernelInitialize(void)
   /* Initialize osInfo */
   memset(&osInfo, 0, sizeof(osInfo));
 
+  libTraceInit();
+
   for (uint32_t i = 0U; i < NUM_PRIORITY; i++) {
     QueueReset(&osInfo.ready_list[i]);
   }
 
   QueueReset(&osInfo.timer_queue);
-  QueueReset(&osInfo.delay_queue);
+  libTimeoutInit();
+  libObjectPoolInit();
+  libMemAllocInit();
+  libHeapInit();
 
   osInfo.kernel.state = osKernelReady;
 
@@ -155,6 +163,12 @@ static osStatus_t KernelStart(void)
   /* Setup RTOS Tick */
   osSysTickInit(osConfig.tick_freq);
 
+  /* Setup Thread runtime accounting */
+  if ((osConfig.flags & osConfigThreadRuntime) != 0U) {
+    archCycleCounterInit();
+    osInfo.runtime.stamp = archCycleCounterGet(osInfo.kernel.tick);
+  }
+
   /* Switch to Ready Thread with highest Priority */
   thread = libThreadHighestPrioGet();
   if (thread == NULL) {
@@ -251,6 +265,58 @@ static int32_t KernelRestoreLock(int32_t lock)
   return (lock_new);
 }
 
+static uint32_t KernelWakeupPending(void)
+{
+  osThread_t *thread = libThreadHighestPrioGet();
+  osThread_t *thread_running = ThreadGetRunning();
+
+  if ((thread != NULL) && (thread_running != NULL) &&
+      (thread->priority > thread_running->priority)) {
+    return (1U);
+  }
+
+  return (0U);
+}
+
+static uint32_t KernelSuspend(void)
+{
+  uint32_t delay;
+
+  if (osInfo.kernel.state != osKernelRunning) {
+    return (0U);
+  }
+
+  /* Expired Timers not yet handled by the Timer Thread or a Thread made ready */
+  if (!isQueueEmpty(&osInfo.timer_queue) || (KernelWakeupPending() != 0U)) {
+    delay = 0U;
+  }
+  else {
+    delay = libTimeoutNext();
+  }
+
+  osInfo.kernel.state = osKernelSuspended;
+
+  return (delay);
+}
+
+static void KernelResume(uint32_t sleep_ticks)
+{
+  if (osInfo.kernel.state != osKernelSuspended) {
+    return;
+  }
+
+  /* Update Kernel Tick */
+  osInfo.kernel.tick += sleep_ticks;
+
+  osInfo.kernel.state = osKernelRunning;
+
+  /* Process all Timers and Thread Delays expired during sleep */
+  KernelTickProcess();
+
+  /* Threads may have been woken by interrupts while suspended */
+  libThreadDispatch(NULL);
+}
+
 static uint32_t KernelGetTickCount(void)
 {
   return (osInfo.kernel.tick);
@@ -261,6 +327,78 @@ static uint32_t KernelGetTickFreq(void)
   return (osConfig.tick_freq);
 }
 
+static uint32_t KernelGetIdlePercent(void)
+{
+  osThread_t *idle = osInfo.thread.idle;
+  uint64_t    cycles;
+
+  if (((osConfig.flags & osConfigThreadRuntime) == 0U) || (idle == NULL)) {
+    return (0U);
+  }
+
+  libThreadRuntimeUpdate();
+
+  if (osInfo.runtime.total == 0U) {
+    return (0U);
+  }
+
+  cycles = idle->runtime.cycles * 100U;
+
+  return ((uint32_t)(cycles / osInfo.runtime.total));
+}
+
+/*******************************************************************************
+ *  Library functions
+ ******************************************************************************/
+
+/**
+ * @brief       Queue an object for post-processing by PendSV (called from ISR).
+ * @param[in]   func    post-processing function.
+ * @param[in]   object  object to process.
+ */
+void libIsrQueuePut(void (*func)(void *), void *object)
+{
+  osIsrRequest_t *request;
+  uint32_t        max = osConfig.isr_queue.max;
+
+  if (archAtomicIncLimit(&osInfo.isr_queue.cnt, max) < max) {
+    request = &osConfig.isr_queue.data[archAtomicIncWrap(&osInfo.isr_queue.in, max)];
+    request->func   = func;
+    request->object = object;
+    archSwitchContextRequest();
+  }
+  else {
+    /* Queue is full, process the object in place */
+    func(object);
+  }
+}
+
+/**
+ * @brief       Process the objects queued by ISRs (executed by PendSV).
+ */
+void libIsrQueueProcess(void)
+{
+  osIsrRequest_t *request;
+  void          (*func)(void *);
+  void           *object;
+  uint32_t        index;
+
+  while (osInfo.isr_queue.cnt != 0U) {
+    index = osInfo.isr_queue.out;
+    request = &osConfig.isr_queue.data[index];
+    func   = request->func;
+    object = request->object;
+
+    if (++index == osConfig.isr_queue.max) {
+      index = 0U;
+    }
+    osInfo.isr_queue.out = index;
+    archAtomicDec(&osInfo.isr_queue.cnt);
+
+    func(object);
+  }
+}
+
 /*******************************************************************************
  *  function implementations (scope: module-exported)
  ******************************************************************************/
@@ -319,7 +457,7 @@ osKernelState_t osKernelGetState(void)
     state = KernelGetState();
   }
   else {
-    state = (osKernelState_t)svc_0((uint32_t)KernelGetState);
+    state = (osKernelState_t)svc_read_0((uint32_t)KernelGetState);
   }
 
   return (state);
@@ -338,7 +476,8 @@ osStatus_t osKernelStart(void)
     status = osErrorISR;
   }
   else {
-    status = (osStatus_t)svc_0((uint32_t)KernelStart);
+    /* Always through SVC: the Thread mode stack is switched to PSP */
+    status = (osStatus_t)(svc_0)((uint32_t)KernelStart);
   }
 
   return (status);
@@ -402,6 +541,58 @@ int32_t osKernelRestoreLock(int32_t lock)
   return (lock_new);
 }
 
+/**
+ * @fn          uint32_t osKernelSuspend(void)
+ * @brief       Suspend the RTOS Kernel scheduler.
+ * @return      time in ticks, for how long the system can sleep or power-down.
+ */
+uint32_t osKernelSuspend(void)
+{
+  uint32_t ticks;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    ticks = 0U;
+  }
+  else {
+    ticks = svc_0((uint32_t)KernelSuspend);
+  }
+
+  return (ticks);
+}
+
+/**
+ * @fn          void osKernelResume(uint32_t sleep_ticks)
+ * @brief       Resume the RTOS Kernel scheduler.
+ * @param[in]   sleep_ticks   time in ticks for how long the system was in sleep or power-down mode.
+ */
+void osKernelResume(uint32_t sleep_ticks)
+{
+  if (!IsIrqMode() && !IsIrqMasked()) {
+    svc_1(sleep_ticks, (uint32_t)KernelResume);
+  }
+}
+
+/**
+ * @fn          uint32_t osKernelWakeupPending(void)
+ * @brief       Check if a Thread of higher priority than the running one is ready.
+ * @return      1 if the Kernel must not sleep, 0 otherwise.
+ * @note        Intended for the tick-less Idle Thread, which calls it with interrupts
+ *              disabled just before the sleep (see \ref osSysTickSleep).
+ */
+uint32_t osKernelWakeupPending(void)
+{
+  uint32_t pending;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    pending = KernelWakeupPending();
+  }
+  else {
+    pending = svc_read_0((uint32_t)KernelWakeupPending);
+  }
+
+  return (pending);
+}
+
 /**
  * @fn          uint32_t osKernelGetTickCount(void)
  * @brief       Get the RTOS kernel tick count.
@@ -415,7 +606,7 @@ uint32_t osKernelGetTickCount(void)
     count = KernelGetTickCount();
   }
   else {
-    count =  svc_0((uint32_t)KernelGetTickCount);
+    count =  svc_read_0((uint32_t)KernelGetTickCount);
   }
 
   return (count);
@@ -434,10 +625,29 @@ uint32_t osKernelGetTickFreq(void)
     freq = KernelGetTickFreq();
   }
   else {
-    freq = svc_0((uint32_t)KernelGetTickFreq);
+    freq = svc_read_0((uint32_t)KernelGetTickFreq);
   }
 
   return (freq);
 }
 
+/**
+ * @fn          uint32_t osKernelGetIdlePercent(void)
+ * @brief       Get the share of time spent in the Idle Thread since the kernel start.
+ * @return      idle time in percent or 0 if thread runtime statistics are disabled.
+ */
+uint32_t osKernelGetIdlePercent(void)
+{
+  uint32_t percent;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    percent = KernelGetIdlePercent();
+  }
+  else {
+    percent = svc_0((uint32_t)KernelGetIdlePercent);
+  }
+
+  return (percent);
+}
+
 /*------------------------------ End of file ---------------------------------*/
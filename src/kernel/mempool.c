@@ -39,27 +39,58 @@ static osMemoryPoolId_t MemoryPoolNew(uint32_t block_count, uint32_t block_size,
   osMemoryPool_t *mp;
   void           *mp_mem;
   uint32_t        mp_size;
+  const char     *name;
+  uint8_t         flags;
 
   /* Check parameters */
-  if ((block_count == 0U) || (block_size  == 0U) || ((__CLZ(block_count) + __CLZ(block_size)) < 32U) || (attr == NULL)) {
+  if ((block_count == 0U) || (block_size  == 0U) || ((__CLZ(block_count) + __CLZ(block_size)) < 32U)) {
     return (NULL);
   }
 
-  mp      = attr->cb_mem;
-  mp_mem  = attr->mp_mem;
-  mp_size = attr->mp_size;
+  if (attr != NULL) {
+    name    = attr->name;
+    mp      = attr->cb_mem;
+    mp_mem  = attr->mp_mem;
+    mp_size = attr->mp_size;
+    /* Check parameters */
+    if (((mp != NULL) && ((((uint32_t)mp & 3U) != 0U) || (attr->cb_size < sizeof(osMemoryPool_t)))) ||
+        ((mp_mem != NULL) && ((((uint32_t)mp_mem & 3U) != 0U) || (mp_size < (block_count * block_size))))) {
+      return (NULL);
+    }
+  }
+  else {
+    name   = NULL;
+    mp     = NULL;
+    mp_mem = NULL;
+  }
 
-  /* Check parameters */
-  if ((mp == NULL) || (((uint32_t)mp & 3U) != 0U) || (attr->cb_size < sizeof(osMemoryPool_t)) ||
-      (mp_mem == NULL) || (((uint32_t)mp_mem & 3U) != 0U) || (mp_size < (block_count * block_size))) {
-    return (NULL);
+  flags = 0U;
+
+  /* Allocate control block and data storage from the Object Memory Pools */
+  if (mp == NULL) {
+    mp = libObjectAlloc(osObjectPoolMemoryPool, sizeof(osMemoryPool_t));
+    if (mp == NULL) {
+      return (NULL);
+    }
+    flags |= osFlagSystemObject;
+  }
+
+  if (mp_mem == NULL) {
+    mp_mem = libObjectAlloc(osObjectPoolMemoryPoolData, block_count * block_size);
+    if (mp_mem == NULL) {
+      if ((flags & osFlagSystemObject) != 0U) {
+        libObjectFree(osObjectPoolMemoryPool, mp);
+      }
+      return (NULL);
+    }
+    flags |= osFlagSystemMemory;
   }
 
   /* Initialize control block */
   mp->id = ID_MEMORYPOOL;
-  mp->flags = 0U;
-  mp->name = attr->name;
-  QueueReset(&mp->wait_queue);
+  mp->flags = flags;
+  mp->name = name;
+  WaitQueueReset(&mp->wait_queue);
   libMemoryPoolInit(block_count, block_size, mp_mem, &mp->info);
 
   return (mp);
@@ -115,9 +146,9 @@ static osStatus_t MemoryPoolFree(osMemoryPoolId_t mp_id, void *block)
   BEGIN_CRITICAL_SECTION
 
   /* Check if Thread is waiting to allocate memory */
-  if (!isQueueEmpty(&mp->wait_queue)) {
+  if (!isWaitQueueEmpty(&mp->wait_queue)) {
     /* Wakeup waiting Thread with highest Priority */
-    libThreadWaitExit(GetThreadByQueue(mp->wait_queue.next), (uint32_t)block, DISPATCH_YES);
+    libThreadWaitExit(WaitQueueHead(&mp->wait_queue), (uint32_t)block, DISPATCH_YES);
     status = osOK;
   }
   else {
@@ -193,6 +224,177 @@ static osStatus_t MemoryPoolDelete(osMemoryPoolId_t mp_id)
   /* Mark object as invalid */
   mp->id = ID_INVALID;
 
+  /* Free object memory */
+  if ((mp->flags & osFlagSystemMemory) != 0U) {
+    libObjectFree(osObjectPoolMemoryPoolData, mp->info.block_base);
+  }
+  if ((mp->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolMemoryPool, mp);
+  }
+
+  return (osOK);
+}
+
+/**
+ * @brief       Get the smallest Memory Allocator size class that can hold size bytes.
+ * @param[in]   size  requested size in bytes (1..osMemClassSizeMax).
+ * @return      size class index.
+ */
+static
+uint32_t MemClassIndex(uint32_t size)
+{
+  return (32U - __CLZ((size - 1U) / osMemClassSizeMin));
+}
+
+/**
+ * @brief       Find the size class whose waiting Thread gets a released block.
+ * @param[in]   idx   size class index of the released block.
+ * @return      size class with the highest priority waiter that the block fits or NULL.
+ * @note        Threads wait on the smallest configured class that fits the request,
+ *              so a block also serves the waiters of all smaller classes. On equal
+ *              priority the waiter of the larger class is served.
+ */
+static osMemClass_t *MemClassWaiting(uint32_t idx)
+{
+  osMemClass_t *mc = NULL;
+  osThread_t   *thread;
+  int8_t        priority = 0;
+
+  for (uint32_t i = 0U; i <= idx; i++) {
+    if (!isWaitQueueEmpty(&osConfig.mem_class[i].wait_queue)) {
+      thread = WaitQueueHead(&osConfig.mem_class[i].wait_queue);
+      if ((mc == NULL) || (thread->priority >= priority)) {
+        mc = &osConfig.mem_class[i];
+        priority = thread->priority;
+      }
+    }
+  }
+
+  return (mc);
+}
+
+static void *MemAlloc(uint32_t size, uint32_t timeout)
+{
+  osMemClass_t *mc;
+  void         *block;
+  uint32_t      idx;
+
+  /* Check parameters */
+  if ((osConfig.mem_class == NULL) || (size == 0U) || (size > osMemClassSizeMax)) {
+    return (NULL);
+  }
+
+  block = NULL;
+  idx = MemClassIndex(size);
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Take a block from the first class that has one, larger classes are tried in order */
+  for (uint32_t i = idx; i < osMemClassNum; i++) {
+    mc = &osConfig.mem_class[i];
+    block = libMemoryPoolAlloc(&mc->info);
+    if (block != NULL) {
+      if (mc->info.used_blocks > mc->max_used) {
+        mc->max_used = mc->info.used_blocks;
+      }
+      break;
+    }
+  }
+
+  if (block == NULL) {
+    /* Account and wait on the smallest configured class that fits */
+    while ((idx < osMemClassNum) && (osConfig.mem_class[idx].info.max_blocks == 0U)) {
+      idx++;
+    }
+    if (idx < osMemClassNum) {
+      mc = &osConfig.mem_class[idx];
+      mc->fail_count++;
+      if (timeout != 0U) {
+        if (libThreadWaitEnter(ThreadGetRunning(), &mc->wait_queue, timeout)) {
+          block = (void *)osThreadWait;
+        }
+      }
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (block);
+}
+
+static osStatus_t MemFree(void *block)
+{
+  osMemClass_t *mc;
+  osMemClass_t *mc_wait;
+  osStatus_t    status;
+  uint32_t      idx;
+
+  /* Check parameters */
+  if ((osConfig.mem_class == NULL) || (block == NULL)) {
+    return (osErrorParameter);
+  }
+
+  /* Find the size class owning the block */
+  for (idx = 0U; idx < osMemClassNum; idx++) {
+    mc = &osConfig.mem_class[idx];
+    if ((block >= mc->info.block_base) && (block < mc->info.block_lim)) {
+      break;
+    }
+  }
+  if ((idx == osMemClassNum) ||
+      ((((uint32_t)block - (uint32_t)mc->info.block_base) & (mc->info.block_size - 1U)) != 0U)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Check if Thread is waiting to allocate memory of this or a smaller class */
+  mc_wait = MemClassWaiting(idx);
+  if (mc_wait != NULL) {
+    /* Wakeup waiting Thread with highest Priority, the block stays in its class */
+    libThreadWaitExit(WaitQueueHead(&mc_wait->wait_queue), (uint32_t)block, DISPATCH_YES);
+    status = osOK;
+  }
+  else {
+    /* Free memory */
+    status = libMemoryPoolFree(&mc->info, block);
+  }
+
+  END_CRITICAL_SECTION
+
+  return (status);
+}
+
+static osStatus_t MemGetStats(uint32_t class_idx, osMemStats_t *stats)
+{
+  const osMemClass_t *mc;
+
+  /* Check parameters */
+  if ((class_idx >= osMemClassNum) || (stats == NULL)) {
+    return (osErrorParameter);
+  }
+
+  stats->block_size = osMemClassSizeMin << class_idx;
+
+  if (osConfig.mem_class == NULL) {
+    stats->capacity   = 0U;
+    stats->used       = 0U;
+    stats->max_used   = 0U;
+    stats->fail_count = 0U;
+    return (osOK);
+  }
+
+  mc = &osConfig.mem_class[class_idx];
+
+  BEGIN_CRITICAL_SECTION
+
+  stats->capacity   = mc->info.max_blocks;
+  stats->used       = mc->info.used_blocks;
+  stats->max_used   = mc->max_used;
+  stats->fail_count = mc->fail_count;
+
+  END_CRITICAL_SECTION
+
   return (osOK);
 }
 
@@ -214,7 +416,6 @@ void libMemoryPoolInit(uint32_t block_count, uint32_t block_size, void *block_me
   mp_info->used_blocks = 0U;
   mp_info->block_size  = block_size;
   mp_info->block_base  = block_mem;
-  mp_info->block_free  = block_mem;
   mp_info->block_lim   = &(((uint8_t *)block_mem)[block_count * block_size]);
 
   /* Reset Memory Pool */
@@ -224,23 +425,14 @@ void libMemoryPoolInit(uint32_t block_count, uint32_t block_size, void *block_me
 /**
  * @brief       Reset Memory Pool.
  * @param[in]   mp_info       memory pool info.
+ * @note        Blocks are not linked here: blocks above the high-water mark are
+ *              handed out in address order, only released blocks enter the free list.
  */
 void libMemoryPoolReset(osMemoryPoolInfo_t *mp_info)
 {
-  void *mem;
-  void *block;
-  uint32_t block_count;
-
-  /* Link all free blocks */
-  mem = mp_info->block_base;
-  block_count = mp_info->max_blocks;
-
-  while (--block_count != 0U) {
-    block = &((uint8_t *)mem)[mp_info->block_size];
-    *((void **)mem) = block;
-    mem = block;
-  }
-  *((void **)mem) = NULL;
+  mp_info->used_blocks = 0U;
+  mp_info->block_free  = NULL;
+  mp_info->block_hwm   = mp_info->block_base;
 }
 
 /**
@@ -261,6 +453,12 @@ void *libMemoryPoolAlloc(osMemoryPoolInfo_t *mp_info)
     mp_info->block_free = *((void **)block);
     mp_info->used_blocks++;
   }
+  else if (mp_info->block_hwm < mp_info->block_lim) {
+    /* Take the next block that was never allocated */
+    block = mp_info->block_hwm;
+    mp_info->block_hwm = &((uint8_t *)block)[mp_info->block_size];
+    mp_info->used_blocks++;
+  }
 
   return (block);
 }
@@ -273,7 +471,7 @@ void *libMemoryPoolAlloc(osMemoryPoolInfo_t *mp_info)
  */
 osStatus_t libMemoryPoolFree(osMemoryPoolInfo_t *mp_info, void *block)
 {
-  if ((mp_info == NULL) || (block < mp_info->block_base) || (block >= mp_info->block_lim)) {
+  if ((mp_info == NULL) || (block < mp_info->block_base) || (block >= mp_info->block_hwm)) {
     return (osErrorParameter);
   }
 
@@ -284,6 +482,92 @@ osStatus_t libMemoryPoolFree(osMemoryPoolInfo_t *mp_info, void *block)
   return (osOK);
 }
 
+/**
+ * @brief       Initialize Object Memory Pools.
+ */
+void libObjectPoolInit(void)
+{
+  const osObjectPool_t *pool;
+
+  for (uint32_t i = 0U; i < osObjectPoolNum; i++) {
+    pool = &osConfig.mpi[i];
+    if (pool->info != NULL) {
+      libMemoryPoolInit(pool->count, pool->size, pool->mem, pool->info);
+    }
+  }
+}
+
+/**
+ * @brief       Initialize Memory Allocator size classes.
+ */
+void libMemAllocInit(void)
+{
+  const osObjectPool_t *pool;
+  osMemClass_t         *mc;
+
+  if (osConfig.mem_class == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0U; i < osMemClassNum; i++) {
+    pool = &osConfig.mem_pool[i];
+    mc = &osConfig.mem_class[i];
+    WaitQueueReset(&mc->wait_queue);
+    mc->max_used   = 0U;
+    mc->fail_count = 0U;
+    if (pool->info != NULL) {
+      libMemoryPoolInit(pool->count, pool->size, pool->mem, pool->info);
+    }
+    else {
+      /* Class is not configured: an empty pool never matches a block address */
+      mc->info.max_blocks  = 0U;
+      mc->info.used_blocks = 0U;
+      mc->info.block_size  = osMemClassSizeMin << i;
+      mc->info.block_base  = NULL;
+      mc->info.block_lim   = NULL;
+      mc->info.block_free  = NULL;
+      mc->info.block_hwm   = NULL;
+    }
+  }
+}
+
+/**
+ * @brief       Allocate a block from an Object Memory Pool.
+ * @param[in]   pool      Object Memory Pool index (osObjectPool*).
+ * @param[in]   size      required block size in bytes.
+ * @return      address of the allocated block or NULL in case the pool is not configured or exhausted.
+ */
+void *libObjectAlloc(uint32_t pool, uint32_t size)
+{
+  void *block;
+
+  if (size > osConfig.mpi[pool].size) {
+    return (NULL);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  block = libMemoryPoolAlloc(osConfig.mpi[pool].info);
+
+  END_CRITICAL_SECTION
+
+  return (block);
+}
+
+/**
+ * @brief       Return a block back to an Object Memory Pool.
+ * @param[in]   pool      Object Memory Pool index (osObjectPool*).
+ * @param[in]   block     address of the block allocated by libObjectAlloc.
+ */
+void libObjectFree(uint32_t pool, void *block)
+{
+  BEGIN_CRITICAL_SECTION
+
+  (void)libMemoryPoolFree(osConfig.mpi[pool].info, block);
+
+  END_CRITICAL_SECTION
+}
+
 /*******************************************************************************
  *  Public API
  ******************************************************************************/
@@ -346,6 +630,7 @@ void *osMemoryPoolAlloc(osMemoryPoolId_t mp_id, uint32_t timeout)
       memory = NULL;
     }
     else {
+      TraceEvent(osTraceIsrCall, (uint32_t)MemoryPoolAlloc, (uint32_t)mp_id);
       memory = MemoryPoolAlloc(mp_id, timeout);
     }
   }
@@ -374,6 +659,7 @@ osStatus_t osMemoryPoolFree(osMemoryPoolId_t mp_id, void *block)
   osStatus_t status;
 
   if (IsIrqMode() || IsIrqMasked()) {
+    TraceEvent(osTraceIsrCall, (uint32_t)MemoryPoolFree, (uint32_t)mp_id);
     status = MemoryPoolFree(mp_id, block);
   }
   else {
@@ -397,7 +683,7 @@ uint32_t osMemoryPoolGetCapacity(osMemoryPoolId_t mp_id)
     capacity = MemoryPoolGetCapacity(mp_id);
   }
   else {
-    capacity = svc_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetCapacity);
+    capacity = svc_read_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetCapacity);
   }
 
   return (capacity);
@@ -417,7 +703,7 @@ uint32_t osMemoryPoolGetBlockSize(osMemoryPoolId_t mp_id)
     block_size = MemoryPoolGetBlockSize(mp_id);
   }
   else {
-    block_size = svc_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetBlockSize);
+    block_size = svc_read_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetBlockSize);
   }
 
   return (block_size);
@@ -437,7 +723,7 @@ uint32_t osMemoryPoolGetCount(osMemoryPoolId_t mp_id)
     count = MemoryPoolGetCount(mp_id);
   }
   else {
-    count = svc_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetCount);
+    count = svc_read_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetCount);
   }
 
   return (count);
@@ -457,7 +743,7 @@ uint32_t osMemoryPoolGetSpace(osMemoryPoolId_t mp_id)
     space = MemoryPoolGetSpace(mp_id);
   }
   else {
-    space = svc_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetSpace);
+    space = svc_read_1((uint32_t)mp_id, (uint32_t)MemoryPoolGetSpace);
   }
 
   return (space);
@@ -483,4 +769,79 @@ osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id)
   return (status);
 }
 
+/**
+ * @fn          void *osMemAlloc(uint32_t size, uint32_t timeout)
+ * @brief       Allocate a memory block from the smallest size class that can hold size bytes.
+ * @param[in]   size      requested size in bytes (1..\ref osMemClassSizeMax).
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      address of the allocated memory block or NULL in case of no memory is available.
+ */
+void *osMemAlloc(uint32_t size, uint32_t timeout)
+{
+  void *memory;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      memory = NULL;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)MemAlloc, size);
+      memory = MemAlloc(size, timeout);
+    }
+  }
+  else {
+    memory = (void *)svc_2(size, timeout, (uint32_t)MemAlloc);
+    if ((int32_t)memory == osThreadWait) {
+      memory = (void *)ThreadGetRunning()->winfo.ret_val;
+      if ((osStatus_t)memory == osErrorTimeout) {
+        memory = NULL;
+      }
+    }
+  }
+
+  return (memory);
+}
+
+/**
+ * @fn          osStatus_t osMemFree(void *block)
+ * @brief       Return a memory block allocated by \ref osMemAlloc.
+ * @param[in]   block   address of the allocated memory block.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemFree(void *block)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    TraceEvent(osTraceIsrCall, (uint32_t)MemFree, (uint32_t)block);
+    status = MemFree(block);
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)block, (uint32_t)MemFree);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osMemGetStats(uint32_t class_idx, osMemStats_t *stats)
+ * @brief       Get usage statistics of a Memory Allocator size class.
+ * @param[in]   class_idx   size class index (0..\ref osMemClassNum - 1).
+ * @param[out]  stats       pointer to buffer for statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMemGetStats(uint32_t class_idx, osMemStats_t *stats)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = MemGetStats(class_idx, stats);
+  }
+  else {
+    status = (osStatus_t)svc_2(class_idx, (uint32_t)stats, (uint32_t)MemGetStats);
+  }
+
+  return (status);
+}
+
 /*------------------------------ End of file ---------------------------------*/
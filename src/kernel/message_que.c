@@ -39,6 +39,9 @@
  *  defines and macros (scope: module-local)
  ******************************************************************************/
 
+#define MESSAGE_FLAG_ALLOC          0x01U   /* Block handed out by osMessageQueueAlloc   */
+#define MESSAGE_FLAG_RECV           0x02U   /* Block handed out by osMessageQueueReceive */
+
 /*******************************************************************************
  *  typedefs and structures (scope: module-local)
  ******************************************************************************/
@@ -59,94 +62,345 @@
  *  function implementations (scope: module-local)
  ******************************************************************************/
 
+/**
+ * @brief       Reset the Message Priority buckets.
+ * @param[in]   mq  message queue object.
+ */
+static void MessagePrioReset(osMessageQueue_t *mq)
+{
+  uint32_t i;
+
+  mq->prio_grp = 0U;
+  for (i = 0U; i < 8U; i++) {
+    mq->prio_bmp[i] = 0U;
+  }
+}
+
+/**
+ * @brief       Find the lowest occupied Message Priority above the given one.
+ * @param[in]   mq    message queue object.
+ * @param[in]   prio  message priority.
+ * @return      message priority or -1 if no Message with higher priority is queued.
+ */
+static int32_t MessagePrioAbove(osMessageQueue_t *mq, uint32_t prio)
+{
+  uint32_t grp;
+  uint32_t bmp;
+
+  grp = prio >> 5;
+  bmp = mq->prio_bmp[grp] & (0xFFFFFFFEU << (prio & 31U));
+  if (bmp == 0U) {
+    bmp = mq->prio_grp & (0xFFFFFFFEU << grp);
+    if (bmp == 0U) {
+      return (-1);
+    }
+    grp = 31U - __CLZ(bmp & (0U - bmp));
+    bmp = mq->prio_bmp[grp];
+  }
+
+  return ((int32_t)((grp << 5) + (31U - __CLZ(bmp & (0U - bmp)))));
+}
+
+/**
+ * @brief       Link a Message into the Queue behind all Messages with the same or higher priority.
+ * @param[in]   mq   message queue object.
+ * @param[in]   msg  message object.
+ */
+static void MessageLink(osMessageQueue_t *mq, osMessage_t *msg)
+{
+  queue_t *que;
+  uint32_t prio;
+  int32_t  above;
+
+  prio = msg->priority;
+
+  if ((mq->prio_bmp[prio >> 5] & (1UL << (prio & 31U))) != 0U) {
+    /* Append to the bucket of the same priority */
+    que = mq->prio_tail[prio]->msg_que.next;
+  }
+  else {
+    /* Start a new bucket behind the nearest higher priority */
+    above = MessagePrioAbove(mq, prio);
+    if (above < 0) {
+      que = mq->msg_queue.next;
+    }
+    else {
+      que = mq->prio_tail[above]->msg_que.next;
+    }
+    mq->prio_bmp[prio >> 5] |= (1UL << (prio & 31U));
+    mq->prio_grp |= (1UL << (prio >> 5));
+  }
+
+  QueueAppend(que, &msg->msg_que);
+  mq->prio_tail[prio] = msg;
+}
+
+/**
+ * @brief       Extract the first Message from the Queue.
+ * @param[in]   mq  message queue object.
+ * @return      message object.
+ */
+static osMessage_t *MessageUnlink(osMessageQueue_t *mq)
+{
+  osMessage_t *msg;
+  uint32_t     prio;
+
+  msg = GetMessageByQueue(QueueExtract(&mq->msg_queue));
+  prio = msg->priority;
+
+  if (mq->prio_tail[prio] == msg) {
+    /* Bucket is empty */
+    mq->prio_bmp[prio >> 5] &= ~(1UL << (prio & 31U));
+    if (mq->prio_bmp[prio >> 5] == 0U) {
+      mq->prio_grp &= ~(1UL << (prio >> 5));
+    }
+  }
+
+  return (msg);
+}
+
+/**
+ * @brief       Allocate a Message block.
+ * @param[in]   mq  message queue object.
+ * @return      message object or NULL in case of no memory is available.
+ */
+static osMessage_t *MessageAlloc(osMessageQueue_t *mq)
+{
+  osMessage_t *msg;
+
+  if (!isQueueEmpty(&mq->msg_reset)) {
+    /* Reuse a Message dropped by osMessageQueueReset */
+    msg = GetMessageByQueue(QueueExtract(&mq->msg_reset));
+    mq->mp_info.used_blocks++;
+  }
+  else {
+    msg = libMemoryPoolAlloc(&mq->mp_info);
+  }
+  if (msg != NULL) {
+    msg->id = ID_MESSAGE;
+    msg->flags = MESSAGE_FLAG_ALLOC;
+  }
+
+  return (msg);
+}
+
+/**
+ * @brief       Return a Message block back to the Memory Pool.
+ * @param[in]   mq   message queue object.
+ * @param[in]   msg  message object.
+ */
+static void MessageFree(osMessageQueue_t *mq, osMessage_t *msg)
+{
+  msg->id = ID_INVALID;
+  (void)libMemoryPoolFree(&mq->mp_info, msg);
+}
+
+/**
+ * @brief       Get the Message block holding the given message data.
+ * @param[in]   mq       message queue object.
+ * @param[in]   msg_ptr  pointer to message data obtained by \ref osMessageQueueAlloc or \ref osMessageQueueReceive.
+ * @param[in]   flags    expected Message flags.
+ * @return      message object or NULL in case of an invalid pointer.
+ */
+static osMessage_t *MessageByPtr(osMessageQueue_t *mq, void *msg_ptr, uint8_t flags)
+{
+  osMessage_t *msg;
+
+  if (msg_ptr == NULL) {
+    return (NULL);
+  }
+
+  msg = (osMessage_t *)msg_ptr - 1;
+  if (((void *)msg < mq->mp_info.block_base) || ((void *)msg >= mq->mp_info.block_hwm) ||
+      ((((uint32_t)msg - (uint32_t)mq->mp_info.block_base) % mq->mp_info.block_size) != 0U) ||
+      (msg->id != ID_MESSAGE) || ((msg->flags & flags) == 0U)) {
+    return (NULL);
+  }
+
+  return (msg);
+}
+
 static osMessage_t *MessagePut(osMessageQueue_t *mq, const void *msg_ptr, uint8_t msg_prio)
 {
-  queue_t     *que;
   osMessage_t *msg;
 
   /* Try to allocate memory */
-  msg = libMemoryPoolAlloc(&mq->mp_info);
+  msg = MessageAlloc(mq);
   if (msg != NULL) {
     /* Copy Message */
     memcpy(&msg[1], msg_ptr, mq->msg_size);
-    msg->id = ID_MESSAGE;
     msg->flags = 0U;
     msg->priority = msg_prio;
     /* Put Message into Queue */
-    que = &mq->msg_queue;
-    if (msg_prio != 0U) {
-      for (que = que->next; que != &mq->msg_queue; que = que->next) {
-        if (GetMessageByQueue(que)->priority < msg_prio) {
-          break;
-        }
-      }
-    }
-    QueueAppend(que, &msg->msg_que);
+    MessageLink(mq, msg);
     mq->msg_count++;
   }
 
   return (msg);
 }
 
-static osMessage_t *MessageGet(osMessageQueue_t *mq, void *msg_ptr, uint8_t *msg_prio)
+/**
+ * @brief       Take the first Message out of the Queue without copying it.
+ * @param[in]   mq        message queue object.
+ * @param[out]  msg_prio  pointer to buffer for message priority or NULL.
+ * @return      message object or NULL in case the Queue is empty.
+ */
+static osMessage_t *MessageReceive(osMessageQueue_t *mq, uint8_t *msg_prio)
 {
-  queue_t     *que;
   osMessage_t *msg;
 
-  que = &mq->msg_queue;
+  if (isQueueEmpty(&mq->msg_queue)) {
+    return (NULL);
+  }
+
+  msg = MessageUnlink(mq);
+  msg->flags = MESSAGE_FLAG_RECV;
+  if (msg_prio != NULL) {
+    *msg_prio = msg->priority;
+  }
+  mq->msg_count--;
+
+  return (msg);
+}
+
+static osMessage_t *MessageGet(osMessageQueue_t *mq, void *msg_ptr, uint8_t *msg_prio)
+{
+  osMessage_t *msg;
 
-  if (!isQueueEmpty(que)) {
-    msg = GetMessageByQueue(QueueExtract(que));
+  msg = MessageReceive(mq, msg_prio);
+  if (msg != NULL) {
     /* Copy Message */
     memcpy(msg_ptr, &msg[1], mq->msg_size);
-    if (msg_prio != NULL) {
-      *msg_prio = msg->priority;
-    }
     /* Free memory */
-    msg->id = ID_INVALID;
-    libMemoryPoolFree(&mq->mp_info, msg);
-    mq->msg_count--;
-  }
-  else {
-    msg = NULL;
+    MessageFree(mq, msg);
   }
 
   return (msg);
 }
 
+/**
+ * @brief       Pass queued Messages to waiting receivers and free blocks to waiting senders.
+ * @param[in]   mq  message queue object.
+ * @note        Threads waiting in \ref osMessageQueueAlloc or \ref osMessageQueueReceive
+ *              have no message buffer (msg == 0) and get the block address as return value.
+ */
+static void MessageQueueDispatch(osMessageQueue_t *mq)
+{
+  osThread_t     *thread;
+  winfo_msgque_t *winfo;
+  osMessage_t    *msg;
+  uint32_t        ret_val;
+  bool            repeat;
+
+  do {
+    repeat = false;
+
+    while (!isWaitQueueEmpty(&mq->wait_get_queue) && !isQueueEmpty(&mq->msg_queue)) {
+      /* Get waiting Thread with highest Priority */
+      thread = WaitQueueHead(&mq->wait_get_queue);
+      winfo = &thread->winfo.msgque;
+      if (winfo->msg != 0U) {
+        (void)MessageGet(mq, (void *)winfo->msg, (uint8_t *)winfo->msg_prio);
+        ret_val = (uint32_t)osOK;
+      }
+      else {
+        msg = MessageReceive(mq, (uint8_t *)winfo->msg_prio);
+        ret_val = (uint32_t)&msg[1];
+      }
+      libThreadWaitExit(thread, ret_val, DISPATCH_NO);
+    }
+
+    while (!isWaitQueueEmpty(&mq->wait_put_queue) && (mq->mp_info.used_blocks < mq->mp_info.max_blocks)) {
+      /* Get waiting Thread with highest Priority */
+      thread = WaitQueueHead(&mq->wait_put_queue);
+      winfo = &thread->winfo.msgque;
+      if (winfo->msg != 0U) {
+        (void)MessagePut(mq, (const void *)winfo->msg, (uint8_t)winfo->msg_prio);
+        ret_val = (uint32_t)osOK;
+        repeat = !isWaitQueueEmpty(&mq->wait_get_queue);
+      }
+      else {
+        msg = MessageAlloc(mq);
+        ret_val = (uint32_t)&msg[1];
+      }
+      libThreadWaitExit(thread, ret_val, DISPATCH_NO);
+    }
+  } while (repeat);
+
+  libThreadDispatch(NULL);
+}
+
 static osMessageQueueId_t MessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
 {
   osMessageQueue_t *mq;
   void             *mq_mem;
   uint32_t          mq_size;
   uint32_t          block_size;
+  const char       *name;
+  uint8_t           flags;
 
   /* Check parameters */
-  if ((msg_count == 0U) || (msg_size  == 0U) || (attr == NULL)) {
+  if ((msg_count == 0U) || (msg_size  == 0U)) {
     return (NULL);
   }
 
-  mq      = attr->cb_mem;
-  mq_mem  = attr->mq_mem;
-  mq_size = attr->mq_size;
   block_size = ((msg_size + 3U) & ~3UL) + sizeof(osMessage_t);
 
   /* Check parameters */
-  if (((__CLZ(msg_count) + __CLZ(block_size)) < 32U) ||
-      (mq == NULL) || (((uint32_t)mq & 3U) != 0U) || (attr->cb_size < sizeof(osMessageQueue_t)) ||
-      (mq_mem == NULL) || (((uint32_t)mq_mem & 3U) != 0U) || (mq_size < (msg_count * block_size))) {
+  if ((__CLZ(msg_count) + __CLZ(block_size)) < 32U) {
     return (NULL);
   }
 
+  if (attr != NULL) {
+    name    = attr->name;
+    mq      = attr->cb_mem;
+    mq_mem  = attr->mq_mem;
+    mq_size = attr->mq_size;
+    /* Check parameters */
+    if (((mq != NULL) && ((((uint32_t)mq & 3U) != 0U) || (attr->cb_size < sizeof(osMessageQueue_t)))) ||
+        ((mq_mem != NULL) && ((((uint32_t)mq_mem & 3U) != 0U) || (mq_size < (msg_count * block_size))))) {
+      return (NULL);
+    }
+  }
+  else {
+    name   = NULL;
+    mq     = NULL;
+    mq_mem = NULL;
+  }
+
+  flags = 0U;
+
+  /* Allocate control block and data storage from the Object Memory Pools */
+  if (mq == NULL) {
+    mq = libObjectAlloc(osObjectPoolMessageQueue, sizeof(osMessageQueue_t));
+    if (mq == NULL) {
+      return (NULL);
+    }
+    flags |= osFlagSystemObject;
+  }
+
+  if (mq_mem == NULL) {
+    mq_mem = libObjectAlloc(osObjectPoolMsgQueueData, msg_count * block_size);
+    if (mq_mem == NULL) {
+      if ((flags & osFlagSystemObject) != 0U) {
+        libObjectFree(osObjectPoolMessageQueue, mq);
+      }
+      return (NULL);
+    }
+    flags |= osFlagSystemMemory;
+  }
+
   /* Initialize control block */
   mq->id = ID_MESSAGE_QUEUE;
-  mq->flags = 0U;
-  mq->name = attr->name;
+  mq->flags = flags;
+  mq->name = name;
   mq->msg_size = msg_size;
   mq->msg_count = 0U;
-  QueueReset(&mq->wait_put_queue);
-  QueueReset(&mq->wait_get_queue);
+  WaitQueueReset(&mq->wait_put_queue);
+  WaitQueueReset(&mq->wait_get_queue);
   QueueReset(&mq->msg_queue);
+  QueueReset(&mq->msg_reset);
+  MessagePrioReset(mq);
   libMemoryPoolInit(msg_count, block_size, mq_mem, &mq->mp_info);
 
   return (mq);
@@ -179,10 +433,11 @@ static osStatus_t MessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr,
 
   BEGIN_CRITICAL_SECTION
 
-  /* Check if Thread is waiting to receive a Message */
-  if (!isQueueEmpty(&mq->wait_get_queue)) {
+  /* Check if Thread is waiting to receive a Message into its buffer */
+  if (!isWaitQueueEmpty(&mq->wait_get_queue) &&
+      (WaitQueueHead(&mq->wait_get_queue)->winfo.msgque.msg != 0U)) {
     /* Wakeup waiting Thread with highest Priority */
-    thread = GetThreadByQueue(mq->wait_get_queue.next);
+    thread = WaitQueueHead(&mq->wait_get_queue);
     libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
     winfo = &thread->winfo.msgque;
     memcpy((void *)winfo->msg, msg_ptr, mq->msg_size);
@@ -195,6 +450,10 @@ static osStatus_t MessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr,
     /* Try to put Message into Queue */
     msg = MessagePut(mq, msg_ptr, msg_prio);
     if (msg != NULL) {
+      if (!isWaitQueueEmpty(&mq->wait_get_queue)) {
+        /* Pass the Message to a Thread waiting in osMessageQueueReceive */
+        MessageQueueDispatch(mq);
+      }
       status = osOK;
     }
     else {
@@ -223,6 +482,60 @@ static osStatus_t MessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr,
   return (status);
 }
 
+/**
+ * @brief       Pass Messages put or released from ISR to waiting Threads (executed by PendSV).
+ * @param[in]   object  message queue object.
+ */
+static void MessageQueuePostProcess(void *object)
+{
+  osMessageQueue_t *mq = object;
+
+  /* Check object state */
+  if (mq->id != ID_MESSAGE_QUEUE) {
+    return;
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  MessageQueueDispatch(mq);
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Put a Message from ISR and defer waking of a waiting Thread.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   pointer to buffer with message to put into a queue.
+ * @param[in]   msg_prio  message priority.
+ * @return      status code that indicates the execution status of the function.
+ */
+static osStatus_t isrMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE) || (msg_ptr == NULL)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Try to put Message into Queue */
+  msg = MessagePut(mq, msg_ptr, msg_prio);
+
+  END_CRITICAL_SECTION
+
+  if (msg == NULL) {
+    /* No memory available */
+    return (osErrorResource);
+  }
+
+  libIsrQueuePut(MessageQueuePostProcess, mq);
+
+  return (osOK);
+}
+
 static osStatus_t MessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout)
 {
   osMessageQueue_t *mq = mq_id;
@@ -243,16 +556,9 @@ static osStatus_t MessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8
 
   if (msg != NULL) {
     /* Check if Thread is waiting to send a Message */
-    if (!isQueueEmpty(&mq->wait_put_queue)) {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(mq->wait_put_queue.next);
-      winfo = &thread->winfo.msgque;
-      /* Try to put Message into Queue */
-      msg = MessagePut(mq, (const void *)winfo->msg, (uint8_t)winfo->msg_prio);
-      if (msg != NULL) {
-        /* Wakeup waiting Thread with highest Priority */
-        libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_YES);
-      }
+    if (!isWaitQueueEmpty(&mq->wait_put_queue)) {
+      /* Pass the freed block to waiting Threads */
+      MessageQueueDispatch(mq);
     }
     status = osOK;
   }
@@ -281,6 +587,225 @@ static osStatus_t MessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8
   return (status);
 }
 
+static void *MessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+  osThread_t       *thread;
+  winfo_msgque_t   *winfo;
+  void             *msg_ptr;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (NULL);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Try to allocate memory */
+  msg = MessageAlloc(mq);
+  if (msg != NULL) {
+    msg_ptr = &msg[1];
+  }
+  else {
+    msg_ptr = NULL;
+    if (timeout != 0U) {
+      /* Suspend current Thread */
+      thread = ThreadGetRunning();
+      if (libThreadWaitEnter(thread, &mq->wait_put_queue, timeout)) {
+        winfo = &thread->winfo.msgque;
+        winfo->msg      = 0U;
+        winfo->msg_prio = 0U;
+        msg_ptr = (void *)osThreadWait;
+      }
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (msg_ptr);
+}
+
+static osStatus_t MessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+  osStatus_t        status;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  msg = MessageByPtr(mq, msg_ptr, MESSAGE_FLAG_ALLOC);
+  if (msg != NULL) {
+    /* Put Message into Queue */
+    msg->flags = 0U;
+    msg->priority = msg_prio;
+    MessageLink(mq, msg);
+    mq->msg_count++;
+    /* Check if Thread is waiting to receive a Message */
+    if (!isWaitQueueEmpty(&mq->wait_get_queue)) {
+      MessageQueueDispatch(mq);
+    }
+    status = osOK;
+  }
+  else {
+    status = osErrorParameter;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (status);
+}
+
+/**
+ * @brief       Send a Message from ISR and defer waking of a waiting Thread.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   pointer to message data obtained by \ref osMessageQueueAlloc.
+ * @param[in]   msg_prio  message priority.
+ * @return      status code that indicates the execution status of the function.
+ */
+static osStatus_t isrMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  msg = MessageByPtr(mq, msg_ptr, MESSAGE_FLAG_ALLOC);
+  if (msg != NULL) {
+    /* Put Message into Queue */
+    msg->flags = 0U;
+    msg->priority = msg_prio;
+    MessageLink(mq, msg);
+    mq->msg_count++;
+  }
+
+  END_CRITICAL_SECTION
+
+  if (msg == NULL) {
+    return (osErrorParameter);
+  }
+
+  libIsrQueuePut(MessageQueuePostProcess, mq);
+
+  return (osOK);
+}
+
+static void *MessageQueueReceive(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+  osThread_t       *thread;
+  winfo_msgque_t   *winfo;
+  void             *msg_ptr;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (NULL);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Take Message out of Queue */
+  msg = MessageReceive(mq, msg_prio);
+  if (msg != NULL) {
+    msg_ptr = &msg[1];
+  }
+  else {
+    msg_ptr = NULL;
+    if (timeout != 0U) {
+      /* Suspend current Thread */
+      thread = ThreadGetRunning();
+      if (libThreadWaitEnter(thread, &mq->wait_get_queue, timeout)) {
+        winfo = &thread->winfo.msgque;
+        winfo->msg      = 0U;
+        winfo->msg_prio = (uint32_t)msg_prio;
+        msg_ptr = (void *)osThreadWait;
+      }
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (msg_ptr);
+}
+
+static osStatus_t MessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+  osStatus_t        status;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  msg = MessageByPtr(mq, msg_ptr, MESSAGE_FLAG_ALLOC | MESSAGE_FLAG_RECV);
+  if (msg != NULL) {
+    /* Free memory */
+    MessageFree(mq, msg);
+    /* Check if Thread is waiting to send a Message */
+    if (!isWaitQueueEmpty(&mq->wait_put_queue)) {
+      MessageQueueDispatch(mq);
+    }
+    status = osOK;
+  }
+  else {
+    status = osErrorParameter;
+  }
+
+  END_CRITICAL_SECTION
+
+  return (status);
+}
+
+/**
+ * @brief       Release a Message block from ISR and defer waking of a waiting Thread.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   pointer to message data obtained by \ref osMessageQueueReceive.
+ * @return      status code that indicates the execution status of the function.
+ */
+static osStatus_t isrMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+{
+  osMessageQueue_t *mq = mq_id;
+  osMessage_t      *msg;
+
+  /* Check parameters */
+  if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  msg = MessageByPtr(mq, msg_ptr, MESSAGE_FLAG_ALLOC | MESSAGE_FLAG_RECV);
+  if (msg != NULL) {
+    /* Free memory */
+    MessageFree(mq, msg);
+  }
+
+  END_CRITICAL_SECTION
+
+  if (msg == NULL) {
+    return (osErrorParameter);
+  }
+
+  libIsrQueuePut(MessageQueuePostProcess, mq);
+
+  return (osOK);
+}
+
 static uint32_t MessageQueueGetCapacity(osMessageQueueId_t mq_id)
 {
   osMessageQueue_t *mq = mq_id;
@@ -326,15 +851,12 @@ static uint32_t MessageQueueGetSpace(osMessageQueueId_t mq_id)
     return (0U);
   }
 
-  return (mq->mp_info.max_blocks - mq->msg_count);
+  return (mq->mp_info.max_blocks - mq->mp_info.used_blocks);
 }
 
 static osStatus_t MessageQueueReset(osMessageQueueId_t mq_id)
 {
   osMessageQueue_t *mq = mq_id;
-  osMessage_t      *msg;
-  osThread_t       *thread;
-  winfo_msgque_t   *winfo;
 
   /* Check parameters */
   if ((mq == NULL) || (mq->id != ID_MESSAGE_QUEUE)) {
@@ -343,26 +865,16 @@ static osStatus_t MessageQueueReset(osMessageQueueId_t mq_id)
 
   BEGIN_CRITICAL_SECTION
 
-  /* Remove Messages from Queue */
+  /* Drop queued Messages at once, they are reused by MessageAlloc before the Memory Pool.
+     Blocks held by osMessageQueueAlloc/Receive are not queued and stay valid. */
+  QueueMove(&mq->msg_reset, &mq->msg_queue);
+  MessagePrioReset(mq);
+  mq->mp_info.used_blocks -= mq->msg_count;
   mq->msg_count = 0U;
-  QueueReset(&mq->msg_queue);
-  libMemoryPoolReset(&mq->mp_info);
 
   /* Check if Threads are waiting to send Messages */
-  if (!isQueueEmpty(&mq->wait_put_queue)) {
-    do {
-      /* Get waiting Thread with highest Priority */
-      thread = GetThreadByQueue(mq->wait_put_queue.next);
-      winfo = &thread->winfo.msgque;
-      /* Try to put Message into Queue */
-      msg = MessagePut(mq, (const void *)winfo->msg, (uint8_t)winfo->msg_prio);
-      if (msg == NULL) {
-        break;
-      }
-      /* Wakeup waiting Thread with highest Priority */
-      libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
-    } while (!isQueueEmpty(&mq->wait_put_queue));
-    libThreadDispatch(NULL);
+  if (!isWaitQueueEmpty(&mq->wait_put_queue)) {
+    MessageQueueDispatch(mq);
   }
 
   END_CRITICAL_SECTION
@@ -386,6 +898,14 @@ static osStatus_t MessageQueueDelete(osMessageQueueId_t mq_id)
   /* Mark object as invalid */
   mq->id = ID_INVALID;
 
+  /* Free object memory */
+  if ((mq->flags & osFlagSystemMemory) != 0U) {
+    libObjectFree(osObjectPoolMsgQueueData, mq->mp_info.block_base);
+  }
+  if ((mq->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolMessageQueue, mq);
+  }
+
   return (osOK);
 }
 
@@ -453,7 +973,13 @@ osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint
       status = osErrorParameter;
     }
     else {
-      status = MessageQueuePut(mq_id, msg_ptr, msg_prio, timeout);
+      TraceEvent(osTraceIsrCall, (uint32_t)MessageQueuePut, (uint32_t)mq_id);
+      if (IsIrqDeferred()) {
+        status = isrMessageQueuePut(mq_id, msg_ptr, msg_prio);
+      }
+      else {
+        status = MessageQueuePut(mq_id, msg_ptr, msg_prio, timeout);
+      }
     }
   }
   else {
@@ -484,6 +1010,7 @@ osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *m
       status = osErrorParameter;
     }
     else {
+      TraceEvent(osTraceIsrCall, (uint32_t)MessageQueueGet, (uint32_t)mq_id);
       status = MessageQueueGet(mq_id, msg_ptr, msg_prio, timeout);
     }
   }
@@ -497,6 +1024,129 @@ osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *m
   return (status);
 }
 
+/**
+ * @fn          void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+ * @brief       Allocate a Message block to be filled in place and sent with \ref osMessageQueueSend.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      pointer to message data or NULL in case of no memory is available.
+ */
+void *osMessageQueueAlloc(osMessageQueueId_t mq_id, uint32_t timeout)
+{
+  void *msg_ptr;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      msg_ptr = NULL;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)MessageQueueAlloc, (uint32_t)mq_id);
+      msg_ptr = MessageQueueAlloc(mq_id, timeout);
+    }
+  }
+  else {
+    msg_ptr = (void *)svc_2((uint32_t)mq_id, timeout, (uint32_t)MessageQueueAlloc);
+    if ((int32_t)msg_ptr == osThreadWait) {
+      msg_ptr = (void *)ThreadGetRunning()->winfo.ret_val;
+      if (((osStatus_t)msg_ptr == osErrorTimeout) || ((osStatus_t)msg_ptr == osErrorResource)) {
+        msg_ptr = NULL;
+      }
+    }
+  }
+
+  return (msg_ptr);
+}
+
+/**
+ * @fn          osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+ * @brief       Put a Message block allocated by \ref osMessageQueueAlloc into a Queue without copying.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   pointer to message data obtained by \ref osMessageQueueAlloc.
+ * @param[in]   msg_prio  message priority.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueSend(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t msg_prio)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    TraceEvent(osTraceIsrCall, (uint32_t)MessageQueueSend, (uint32_t)mq_id);
+    if (IsIrqDeferred()) {
+      status = isrMessageQueueSend(mq_id, msg_ptr, msg_prio);
+    }
+    else {
+      status = MessageQueueSend(mq_id, msg_ptr, msg_prio);
+    }
+  }
+  else {
+    status = (osStatus_t)svc_3((uint32_t)mq_id, (uint32_t)msg_ptr, msg_prio, (uint32_t)MessageQueueSend);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          void *osMessageQueueReceive(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+ * @brief       Take a Message out of a Queue without copying or timeout if Queue is empty.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[out]  msg_prio  pointer to buffer for message priority or NULL.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      pointer to message data or NULL in case of no message is available.
+ * @note        The block must be returned with \ref osMessageQueueRelease.
+ */
+void *osMessageQueueReceive(osMessageQueueId_t mq_id, uint8_t *msg_prio, uint32_t timeout)
+{
+  void *msg_ptr;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      msg_ptr = NULL;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)MessageQueueReceive, (uint32_t)mq_id);
+      msg_ptr = MessageQueueReceive(mq_id, msg_prio, timeout);
+    }
+  }
+  else {
+    msg_ptr = (void *)svc_3((uint32_t)mq_id, (uint32_t)msg_prio, timeout, (uint32_t)MessageQueueReceive);
+    if ((int32_t)msg_ptr == osThreadWait) {
+      msg_ptr = (void *)ThreadGetRunning()->winfo.ret_val;
+      if (((osStatus_t)msg_ptr == osErrorTimeout) || ((osStatus_t)msg_ptr == osErrorResource)) {
+        msg_ptr = NULL;
+      }
+    }
+  }
+
+  return (msg_ptr);
+}
+
+/**
+ * @fn          osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+ * @brief       Return a Message block obtained by \ref osMessageQueueReceive or \ref osMessageQueueAlloc.
+ * @param[in]   mq_id     message queue ID obtained by \ref osMessageQueueNew.
+ * @param[in]   msg_ptr   pointer to message data.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageQueueRelease(osMessageQueueId_t mq_id, void *msg_ptr)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    TraceEvent(osTraceIsrCall, (uint32_t)MessageQueueRelease, (uint32_t)mq_id);
+    if (IsIrqDeferred()) {
+      status = isrMessageQueueRelease(mq_id, msg_ptr);
+    }
+    else {
+      status = MessageQueueRelease(mq_id, msg_ptr);
+    }
+  }
+  else {
+    status = (osStatus_t)svc_2((uint32_t)mq_id, (uint32_t)msg_ptr, (uint32_t)MessageQueueRelease);
+  }
+
+  return (status);
+}
+
 /**
  * @fn          uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id)
  * @brief       Get maximum number of messages in a Message Queue.
@@ -511,7 +1161,7 @@ uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id)
     capacity = MessageQueueGetCapacity(mq_id);
   }
   else {
-    capacity = svc_1((uint32_t)mq_id, (uint32_t)MessageQueueGetCapacity);
+    capacity = svc_read_1((uint32_t)mq_id, (uint32_t)MessageQueueGetCapacity);
   }
 
   return (capacity);
@@ -531,7 +1181,7 @@ uint32_t osMessageQueueGetMsgSize(osMessageQueueId_t mq_id)
     msg_size = MessageQueueGetMsgSize(mq_id);
   }
   else {
-    msg_size = svc_1((uint32_t)mq_id, (uint32_t)MessageQueueGetMsgSize);
+    msg_size = svc_read_1((uint32_t)mq_id, (uint32_t)MessageQueueGetMsgSize);
   }
 
   return (msg_size);
@@ -551,7 +1201,7 @@ uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id)
     count = MessageQueueGetCount(mq_id);
   }
   else {
-    count = svc_1((uint32_t)mq_id, (uint32_t)MessageQueueGetCount);
+    count = svc_read_1((uint32_t)mq_id, (uint32_t)MessageQueueGetCount);
   }
 
   return (count);
@@ -571,7 +1221,7 @@ uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id)
     space = MessageQueueGetSpace(mq_id);
   }
   else {
-    space = svc_1((uint32_t)mq_id, (uint32_t)MessageQueueGetSpace);
+    space = svc_read_1((uint32_t)mq_id, (uint32_t)MessageQueueGetSpace);
   }
 
   return (space);
@@ -73,8 +73,13 @@ static void RestoreThreadPriority(osThread_t *thread)
     que = thread->mutex_que.next;
     while (que != &thread->mutex_que) {
       mutex = GetMutexByQueque(que);
-      if (!isQueueEmpty(&mutex->wait_que)) {
-        wthread = GetThreadByQueue(mutex->wait_que.next);
+      if ((mutex->attr & osMutexPrioCeiling) != 0U) {
+        if (mutex->prio_ceiling > priority) {
+          priority = mutex->prio_ceiling;
+        }
+      }
+      else if (!isWaitQueueEmpty(&mutex->wait_que)) {
+        wthread = WaitQueueHead(&mutex->wait_que);
         if (wthread->priority > priority) {
           priority = wthread->priority;
         }
@@ -86,30 +91,184 @@ static void RestoreThreadPriority(osThread_t *thread)
   libThreadSetPriority(thread, priority);
 }
 
+/**
+ * @brief       Raise priority of the Mutex owner to the ceiling priority.
+ * @param[in]   mutex     mutex object.
+ * @param[in]   thread    new owner thread.
+ */
+static void MutexCeilingApply(osMutex_t *mutex, osThread_t *thread)
+{
+  if (((mutex->attr & osMutexPrioCeiling) != 0U) && (thread->priority < mutex->prio_ceiling)) {
+    libThreadSetPriority(thread, mutex->prio_ceiling);
+  }
+}
+
+/**
+ * @brief       Propagate priority of a waiting thread along the chain of Mutex owners.
+ * @param[in]   mutex     mutex object the thread is going to wait for.
+ * @param[in]   priority  priority of the waiting thread.
+ */
+static void MutexInheritPriority(osMutex_t *mutex, int8_t priority)
+{
+  osThread_t *thread;
+
+  for (uint32_t depth = osConfig.inherit_depth; depth != 0U; depth--) {
+    if ((mutex->attr & osMutexPrioInherit) == 0U) {
+      break;
+    }
+
+    /* Raise priority of owner Thread if lower than priority of waiting Thread */
+    thread = mutex->holder;
+    if ((thread == NULL) || (thread->priority >= priority)) {
+      break;
+    }
+    libThreadSetPriority(thread, priority);
+
+    /* Continue with the Mutex the owner Thread is blocked on */
+    mutex = thread->wait_mutex;
+    if ((thread->state != ThreadStateBlocked) ||
+        (mutex == NULL) || (thread->wait_queue != &mutex->wait_que)) {
+      break;
+    }
+  }
+}
+
+#if (ARCH_EXCLUSIVE_ACCESS != 0U)
+
+/**
+ * @brief       Lock a free Mutex without entering the kernel.
+ * @param[in]   mutex     mutex object.
+ * @return      true - mutex locked, false - kernel call is required.
+ * @note        The Mutex is not linked into the owner list. The kernel links it
+ *              when another Thread starts to wait for it.
+ */
+static bool MutexFastAcquire(osMutex_t *mutex)
+{
+  osThread_t *thread = ThreadGetRunning();
+
+  /* Ceiling and robust Mutexes are always handled by the kernel */
+  if ((mutex == NULL) || (mutex->id != ID_MUTEX) || (thread == NULL) ||
+      ((mutex->attr & (osMutexPrioCeiling | osMutexRobust)) != 0U)) {
+    return (false);
+  }
+
+  /* Recursive lock (only the owner changes the lock counter) */
+  if (mutex->holder == thread) {
+    if (((mutex->attr & osMutexRecursive) == 0U) || (mutex->cnt == osMutexLockLimit)) {
+      return (false);
+    }
+    mutex->cnt++;
+    return (true);
+  }
+
+  do {
+    if (__LDREXW((volatile uint32_t *)&mutex->holder) != 0U) {
+      __CLREX();
+      return (false);
+    }
+  } while (__STREXW((uint32_t)thread, (volatile uint32_t *)&mutex->holder) != 0U);
+
+  mutex->cnt = 1U;
+
+  return (true);
+}
+
+/**
+ * @brief       Unlock a Mutex without entering the kernel when no Thread is waiting.
+ * @param[in]   mutex     mutex object.
+ * @return      true - mutex unlocked, false - kernel call is required.
+ */
+static bool MutexFastRelease(osMutex_t *mutex)
+{
+  osThread_t *thread = ThreadGetRunning();
+
+  if ((mutex == NULL) || (mutex->id != ID_MUTEX) || (thread == NULL) || (mutex->holder != thread)) {
+    return (false);
+  }
+
+  if (mutex->cnt > 1U) {
+    mutex->cnt--;
+    return (true);
+  }
+
+  /* Any exception between LDREX and STREX (a Thread starting to wait) fails the STREX */
+  *(volatile uint32_t *)&mutex->cnt = 0U;
+  do {
+    if ((__LDREXW((volatile uint32_t *)&mutex->holder) != (uint32_t)thread) ||
+        (*(volatile uint32_t *)&mutex->wait_que.bmp != 0U) ||
+        (*(queue_t * volatile *)&mutex->mutex_que.next != &mutex->mutex_que)) {
+      __CLREX();
+      *(volatile uint32_t *)&mutex->cnt = 1U;
+      return (false);
+    }
+  } while (__STREXW(0U, (volatile uint32_t *)&mutex->holder) != 0U);
+
+  return (true);
+}
+
+#else
+
+#define MutexFastAcquire(mutex)       (false)
+#define MutexFastRelease(mutex)       (false)
+
+#endif
+
 static osMutexId_t MutexNew(const osMutexAttr_t *attr)
 {
-  osMutex_t *mutex;
+  osMutex_t    *mutex;
+  const char   *name;
+  uint32_t      attr_bits;
+  osPriority_t  prio_ceiling;
+  uint8_t       flags;
+
+  if (attr != NULL) {
+    name         = attr->name;
+    attr_bits    = attr->attr_bits;
+    prio_ceiling = attr->prio_ceiling;
+    mutex        = attr->cb_mem;
+    /* Check parameters */
+    if ((mutex != NULL) && ((((uint32_t)mutex & 3U) != 0U) || (attr->cb_size < sizeof(osMutex_t)))) {
+      return (NULL);
+    }
+  }
+  else {
+    name         = NULL;
+    attr_bits    = 0U;
+    prio_ceiling = osPriorityNone;
+    mutex        = NULL;
+  }
 
-  /* Check parameters */
-  if (attr == NULL) {
-    return (NULL);
+  /* Check ceiling priority */
+  if ((attr_bits & osMutexPrioCeiling) != 0U) {
+    if (((attr_bits & osMutexPrioInherit) != 0U) ||
+        (prio_ceiling < osPriorityIdle) || (prio_ceiling > osPriorityISR)) {
+      return (NULL);
+    }
+  }
+  else {
+    prio_ceiling = osPriorityNone;
   }
 
-  mutex = attr->cb_mem;
+  flags = 0U;
 
-  /* Check parameters */
-  if ((mutex == NULL) || (((uint32_t)mutex & 3U) != 0U) || (attr->cb_size < sizeof(osMutex_t))) {
-    return (NULL);
+  /* Allocate control block from the Object Memory Pool */
+  if (mutex == NULL) {
+    mutex = libObjectAlloc(osObjectPoolMutex, sizeof(osMutex_t));
+    if (mutex == NULL) {
+      return (NULL);
+    }
+    flags = osFlagSystemObject;
   }
 
   /* Initialize control block */
   mutex->id     = ID_MUTEX;
-  mutex->flags  = 0U;
-  mutex->attr   = (uint8_t)attr->attr_bits;
-  mutex->name   = attr->name;
+  mutex->flags  = flags;
+  mutex->attr   = (uint8_t)attr_bits;
+  mutex->name   = name;
   mutex->holder = NULL;
   mutex->cnt    = 0U;
-  QueueReset(&mutex->wait_que);
+  mutex->prio_ceiling = (int8_t)prio_ceiling;
+  WaitQueueReset(&mutex->wait_que);
   QueueReset(&mutex->mutex_que);
 
   return (mutex);
@@ -143,12 +302,20 @@ static osStatus_t MutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
     return (osError);
   }
 
+  /* Thread with priority above the ceiling must not lock the Mutex */
+  if (((mutex->attr & osMutexPrioCeiling) != 0U) &&
+      (running_thread->base_priority > mutex->prio_ceiling)) {
+    return (osErrorParameter);
+  }
+
   /* Check if Mutex is not locked */
-  if (mutex->cnt == 0U) {
+  if (mutex->holder == NULL) {
     /* Acquire Mutex */
     mutex->holder = running_thread;
     mutex->cnt = 1U;
     QueueAppend(&running_thread->mutex_que, &mutex->mutex_que);
+    /* Raise priority to the ceiling */
+    MutexCeilingApply(mutex, running_thread);
     status = osOK;
   }
   else {
@@ -166,15 +333,15 @@ static osStatus_t MutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
     else {
       /* Check if timeout is specified */
       if (timeout != 0U) {
-        /* Check if Priority inheritance protocol is enabled */
-        if ((mutex->attr & osMutexPrioInherit) != 0U) {
-          /* Raise priority of owner Task if lower than priority of running Task */
-          if (mutex->holder->priority < running_thread->priority) {
-            libThreadSetPriority(mutex->holder, running_thread->priority);
-          }
+        /* Link Mutex locked without the kernel into the owner list */
+        if (isQueueEmpty(&mutex->mutex_que)) {
+          QueueAppend(&mutex->holder->mutex_que, &mutex->mutex_que);
         }
+        /* Priority inheritance protocol */
+        MutexInheritPriority(mutex, running_thread->priority);
         /* Suspend current Thread */
         if (libThreadWaitEnter(running_thread, &mutex->wait_que, timeout)) {
+          running_thread->wait_mutex = mutex;
           status = (osStatus_t)osThreadWait;
         }
         else {
@@ -206,11 +373,6 @@ static osStatus_t MutexRelease(osMutexId_t mutex_id)
     return (osError);
   }
 
-  /* Check if Mutex is not locked */
-  if (mutex->cnt == 0U) {
-    return (osErrorResource);
-  }
-
   /* Check if running Thread is not the owner */
   if (mutex->holder != running_thread) {
     return (osErrorResource);
@@ -225,18 +387,22 @@ static osStatus_t MutexRelease(osMutexId_t mutex_id)
     QueueRemoveEntry(&mutex->mutex_que);
 
     /* Restore owner Thread priority */
-    if ((mutex->attr & osMutexPrioInherit) != 0U) {
+    if ((mutex->attr & (osMutexPrioInherit | osMutexPrioCeiling)) != 0U) {
       RestoreThreadPriority(running_thread);
     }
 
     /* Check if Thread is waiting for a Mutex */
-    if (!isQueueEmpty(&mutex->wait_que)) {
+    if (!isWaitQueueEmpty(&mutex->wait_que)) {
       /* Wakeup waiting Thread with highest Priority */
-      thread = GetThreadByQueue(mutex->wait_que.next);
+      thread = WaitQueueHead(&mutex->wait_que);
       libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
       mutex->holder = thread;
       mutex->cnt = 1U;
       QueueAppend(&thread->mutex_que, &mutex->mutex_que);
+      MutexCeilingApply(mutex, thread);
+    }
+    else {
+      mutex->holder = NULL;
     }
 
     libThreadDispatch(NULL);
@@ -254,10 +420,6 @@ static osThreadId_t MutexGetOwner(osMutexId_t mutex_id)
     return (NULL);
   }
 
-  if (mutex->cnt == 0U) {
-    return (NULL);
-  }
-
   return (mutex->holder);
 }
 
@@ -271,12 +433,12 @@ static osStatus_t MutexDelete(osMutexId_t mutex_id)
   }
 
   /* Check if Mutex is locked */
-  if (mutex->cnt != 0U) {
+  if (mutex->holder != NULL) {
     /* Remove Mutex from Thread owner list */
     QueueRemoveEntry(&mutex->mutex_que);
 
     /* Restore owner Thread priority */
-    if ((mutex->attr & osMutexPrioInherit) != 0U) {
+    if ((mutex->attr & (osMutexPrioInherit | osMutexPrioCeiling)) != 0U) {
       RestoreThreadPriority(mutex->holder);
     }
 
@@ -289,6 +451,11 @@ static osStatus_t MutexDelete(osMutexId_t mutex_id)
   /* Mutex not exists now */
   mutex->id = ID_INVALID;
 
+  /* Free object memory */
+  if ((mutex->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolMutex, mutex);
+  }
+
   return (osOK);
 }
 
@@ -296,6 +463,46 @@ static osStatus_t MutexDelete(osMutexId_t mutex_id)
  *  Library functions
  ******************************************************************************/
 
+/**
+ * @brief       Recalculate inherited priorities after a Thread stopped waiting for a Mutex.
+ * @param[in]   mutex     mutex object the Thread has been waiting for.
+ * @note        Called when the waiting Thread leaves on timeout, resume or termination.
+ *              The chain of owners is walked at most inherit_depth steps.
+ */
+void libMutexWaitAbort(osMutex_t *mutex)
+{
+  osThread_t *thread;
+  int8_t      priority;
+
+  BEGIN_CRITICAL_SECTION
+
+  for (uint32_t depth = osConfig.inherit_depth; depth != 0U; depth--) {
+    if ((mutex->attr & osMutexPrioInherit) == 0U) {
+      break;
+    }
+
+    /* Drop the priority of the owner Thread to the remaining waiters */
+    thread = mutex->holder;
+    if (thread == NULL) {
+      break;
+    }
+    priority = thread->priority;
+    RestoreThreadPriority(thread);
+    if (thread->priority == priority) {
+      break;
+    }
+
+    /* Continue with the Mutex the owner Thread is blocked on */
+    mutex = thread->wait_mutex;
+    if ((thread->state != ThreadStateBlocked) ||
+        (mutex == NULL) || (thread->wait_queue != &mutex->wait_que)) {
+      break;
+    }
+  }
+
+  END_CRITICAL_SECTION
+}
+
 /**
  * @brief       Release Mutexes when owner Task terminates.
  * @param[in]   que   Queue of mutexes
@@ -311,13 +518,14 @@ void libMutexOwnerRelease(queue_t *que)
       mutex->holder = NULL;
       mutex->cnt = 0U;
       /* Check if Thread is waiting for a Mutex */
-      if (!isQueueEmpty(&mutex->wait_que)) {
+      if (!isWaitQueueEmpty(&mutex->wait_que)) {
         /* Wakeup waiting Thread with highest Priority */
-        thread = GetThreadByQueue(mutex->wait_que.next);
+        thread = WaitQueueHead(&mutex->wait_que);
         libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
         mutex->holder = thread;
         mutex->cnt = 1U;
         QueueAppend(&thread->mutex_que, &mutex->mutex_que);
+        MutexCeilingApply(mutex, thread);
       }
     }
   }
@@ -382,9 +590,14 @@ osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
     status = osErrorISR;
   }
   else {
-    status = (osStatus_t)svc_2((uint32_t)mutex_id, timeout, (uint32_t)MutexAcquire);
-    if (status == osThreadWait) {
-      status = (osStatus_t)ThreadGetRunning()->winfo.ret_val;
+    if (MutexFastAcquire(mutex_id)) {
+      status = osOK;
+    }
+    else {
+      status = (osStatus_t)svc_2((uint32_t)mutex_id, timeout, (uint32_t)MutexAcquire);
+      if (status == osThreadWait) {
+        status = (osStatus_t)ThreadGetRunning()->winfo.ret_val;
+      }
     }
   }
 
@@ -404,6 +617,9 @@ osStatus_t osMutexRelease(osMutexId_t mutex_id)
   if (IsIrqMode() || IsIrqMasked()) {
     status = osErrorISR;
   }
+  else if (MutexFastRelease(mutex_id)) {
+    status = osOK;
+  }
   else {
     status = (osStatus_t)svc_1((uint32_t)mutex_id, (uint32_t)MutexRelease);
   }
@@ -425,7 +641,7 @@ osThreadId_t osMutexGetOwner(osMutexId_t mutex_id)
     thread = NULL;
   }
   else {
-    thread = (osThreadId_t)svc_1((uint32_t)mutex_id, (uint32_t)MutexGetOwner);
+    thread = (osThreadId_t)svc_read_1((uint32_t)mutex_id, (uint32_t)MutexGetOwner);
   }
 
   return (thread);
@@ -23,6 +23,11 @@
 
 osInfo_t osInfo;
 
+#if (OS_TRACE_ENABLE != 0)
+/* Trace Buffer */
+osTrace_t osTrace __USED __attribute__((section(".bss.os.trace")));
+#endif
+
 /* Idle Thread Control Block */
 static osThread_t os_idle_thread_cb __attribute__((section(".bss.os.thread.cb")));
 
@@ -47,6 +52,7 @@ static const osThreadAttr_t os_idle_thread_attr = {
 #else
   0U,
 #endif
+  0U,
   0U
 };
 
@@ -74,9 +80,189 @@ static const osThreadAttr_t os_timer_thread_attr = {
 #else
   0U,
 #endif
+  0U,
   0U
 };
 
+#if (OS_ISR_QUEUE_SIZE != 0)
+/* ISR Post-processing Queue */
+static osIsrRequest_t os_isr_queue[OS_ISR_QUEUE_SIZE] __attribute__((section(".bss.os")));
+#endif
+
+/* Object Memory Pools */
+#define OS_MPI_NONE                 { NULL, NULL, 0U, 0U }
+
+#if (OS_THREAD_STACK_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_stack __attribute__((section(".bss.os.mempool")));
+static uint64_t os_thread_stack[OS_THREAD_STACK_NUM][OS_STACK_SIZE/8] __attribute__((section(".bss.os.thread.stack")));
+#define OS_MPI_STACK                { &os_mpi_stack, &os_thread_stack[0][0], OS_THREAD_STACK_NUM, sizeof(os_thread_stack[0]) }
+#else
+#define OS_MPI_STACK                OS_MPI_NONE
+#endif
+
+#if (OS_THREAD_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_thread __attribute__((section(".bss.os.mempool")));
+static osThread_t os_thread_cb[OS_THREAD_NUM] __attribute__((section(".bss.os.thread.cb")));
+#define OS_MPI_THREAD               { &os_mpi_thread, &os_thread_cb[0], OS_THREAD_NUM, sizeof(osThread_t) }
+#else
+#define OS_MPI_THREAD               OS_MPI_NONE
+#endif
+
+#if (OS_TIMER_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_timer __attribute__((section(".bss.os.mempool")));
+static osTimer_t os_timer_cb[OS_TIMER_NUM] __attribute__((section(".bss.os.timer.cb")));
+#define OS_MPI_TIMER                { &os_mpi_timer, &os_timer_cb[0], OS_TIMER_NUM, sizeof(osTimer_t) }
+#else
+#define OS_MPI_TIMER                OS_MPI_NONE
+#endif
+
+#if (OS_EVFLAGS_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_event_flags __attribute__((section(".bss.os.mempool")));
+static osEventFlags_t os_event_flags_cb[OS_EVFLAGS_NUM] __attribute__((section(".bss.os.evflags.cb")));
+#define OS_MPI_EVFLAGS              { &os_mpi_event_flags, &os_event_flags_cb[0], OS_EVFLAGS_NUM, sizeof(osEventFlags_t) }
+#else
+#define OS_MPI_EVFLAGS              OS_MPI_NONE
+#endif
+
+#if (OS_MUTEX_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_mutex __attribute__((section(".bss.os.mempool")));
+static osMutex_t os_mutex_cb[OS_MUTEX_NUM] __attribute__((section(".bss.os.mutex.cb")));
+#define OS_MPI_MUTEX                { &os_mpi_mutex, &os_mutex_cb[0], OS_MUTEX_NUM, sizeof(osMutex_t) }
+#else
+#define OS_MPI_MUTEX                OS_MPI_NONE
+#endif
+
+#if (OS_SEMAPHORE_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_semaphore __attribute__((section(".bss.os.mempool")));
+static osSemaphore_t os_semaphore_cb[OS_SEMAPHORE_NUM] __attribute__((section(".bss.os.semaphore.cb")));
+#define OS_MPI_SEMAPHORE            { &os_mpi_semaphore, &os_semaphore_cb[0], OS_SEMAPHORE_NUM, sizeof(osSemaphore_t) }
+#else
+#define OS_MPI_SEMAPHORE            OS_MPI_NONE
+#endif
+
+#if (OS_MEMPOOL_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_mempool __attribute__((section(".bss.os.mempool")));
+static osMemoryPool_t os_mempool_cb[OS_MEMPOOL_NUM] __attribute__((section(".bss.os.mempool.cb")));
+#define OS_MPI_MEMPOOL              { &os_mpi_mempool, &os_mempool_cb[0], OS_MEMPOOL_NUM, sizeof(osMemoryPool_t) }
+#if (OS_MEMPOOL_DATA_SIZE != 0)
+static osMemoryPoolInfo_t os_mpi_mempool_data __attribute__((section(".bss.os.mempool")));
+static uint64_t os_mempool_data[OS_MEMPOOL_NUM][OS_MEMPOOL_DATA_SIZE/8] __attribute__((section(".bss.os.mempool.mem")));
+#define OS_MPI_MEMPOOL_DATA         { &os_mpi_mempool_data, &os_mempool_data[0][0], OS_MEMPOOL_NUM, sizeof(os_mempool_data[0]) }
+#endif
+#else
+#define OS_MPI_MEMPOOL              OS_MPI_NONE
+#endif
+#ifndef OS_MPI_MEMPOOL_DATA
+#define OS_MPI_MEMPOOL_DATA         OS_MPI_NONE
+#endif
+
+#if (OS_MSGQUEUE_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_msgqueue __attribute__((section(".bss.os.mempool")));
+static osMessageQueue_t os_msgqueue_cb[OS_MSGQUEUE_NUM] __attribute__((section(".bss.os.msgqueue.cb")));
+#define OS_MPI_MSGQUEUE             { &os_mpi_msgqueue, &os_msgqueue_cb[0], OS_MSGQUEUE_NUM, sizeof(osMessageQueue_t) }
+#if (OS_MSGQUEUE_DATA_SIZE != 0)
+static osMemoryPoolInfo_t os_mpi_msgqueue_data __attribute__((section(".bss.os.mempool")));
+static uint64_t os_msgqueue_data[OS_MSGQUEUE_NUM][OS_MSGQUEUE_DATA_SIZE/8] __attribute__((section(".bss.os.msgqueue.mem")));
+#define OS_MPI_MSGQUEUE_DATA        { &os_mpi_msgqueue_data, &os_msgqueue_data[0][0], OS_MSGQUEUE_NUM, sizeof(os_msgqueue_data[0]) }
+#endif
+#else
+#define OS_MPI_MSGQUEUE             OS_MPI_NONE
+#endif
+#ifndef OS_MPI_MSGQUEUE_DATA
+#define OS_MPI_MSGQUEUE_DATA        OS_MPI_NONE
+#endif
+
+#if (OS_DATAQUEUE_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_dataqueue __attribute__((section(".bss.os.mempool")));
+static osDataQueue_t os_dataqueue_cb[OS_DATAQUEUE_NUM] __attribute__((section(".bss.os.dataqueue.cb")));
+#define OS_MPI_DATAQUEUE            { &os_mpi_dataqueue, &os_dataqueue_cb[0], OS_DATAQUEUE_NUM, sizeof(osDataQueue_t) }
+#if (OS_DATAQUEUE_DATA_SIZE != 0)
+static osMemoryPoolInfo_t os_mpi_dataqueue_data __attribute__((section(".bss.os.mempool")));
+static uint64_t os_dataqueue_data[OS_DATAQUEUE_NUM][OS_DATAQUEUE_DATA_SIZE/8] __attribute__((section(".bss.os.dataqueue.mem")));
+#define OS_MPI_DATAQUEUE_DATA       { &os_mpi_dataqueue_data, &os_dataqueue_data[0][0], OS_DATAQUEUE_NUM, sizeof(os_dataqueue_data[0]) }
+#endif
+#else
+#define OS_MPI_DATAQUEUE            OS_MPI_NONE
+#endif
+#ifndef OS_MPI_DATAQUEUE_DATA
+#define OS_MPI_DATAQUEUE_DATA       OS_MPI_NONE
+#endif
+
+#if (OS_STREAMBUF_NUM != 0)
+static osMemoryPoolInfo_t os_mpi_streambuf __attribute__((section(".bss.os.mempool")));
+static osStreamBuffer_t os_streambuf_cb[OS_STREAMBUF_NUM] __attribute__((section(".bss.os.streambuf.cb")));
+#define OS_MPI_STREAMBUF            { &os_mpi_streambuf, &os_streambuf_cb[0], OS_STREAMBUF_NUM, sizeof(osStreamBuffer_t) }
+#if (OS_STREAMBUF_DATA_SIZE != 0)
+static osMemoryPoolInfo_t os_mpi_streambuf_data __attribute__((section(".bss.os.mempool")));
+static uint64_t os_streambuf_data[OS_STREAMBUF_NUM][OS_STREAMBUF_DATA_SIZE/8] __attribute__((section(".bss.os.streambuf.mem")));
+#define OS_MPI_STREAMBUF_DATA       { &os_mpi_streambuf_data, &os_streambuf_data[0][0], OS_STREAMBUF_NUM, sizeof(os_streambuf_data[0]) }
+#endif
+#else
+#define OS_MPI_STREAMBUF            OS_MPI_NONE
+#endif
+#ifndef OS_MPI_STREAMBUF_DATA
+#define OS_MPI_STREAMBUF_DATA       OS_MPI_NONE
+#endif
+
+/* Memory Allocator */
+#define OS_MEMALLOC_NUM             (OS_MEMALLOC_16_NUM  + OS_MEMALLOC_32_NUM  + OS_MEMALLOC_64_NUM + \
+                                     OS_MEMALLOC_128_NUM + OS_MEMALLOC_256_NUM + OS_MEMALLOC_512_NUM)
+
+#if (OS_MEMALLOC_NUM != 0)
+static osMemClass_t os_mem_class[osMemClassNum] __attribute__((section(".bss.os.memalloc")));
+#define OS_MEM_CLASS                &os_mem_class[0]
+#else
+#define OS_MEM_CLASS                NULL
+#endif
+
+#if (OS_MEMALLOC_16_NUM != 0)
+static uint64_t os_mem_16[OS_MEMALLOC_16_NUM][16/8] __attribute__((section(".bss.os.memalloc.mem")));
+#define OS_MPI_MEM_16               { &os_mem_class[0].info, &os_mem_16[0][0], OS_MEMALLOC_16_NUM, sizeof(os_mem_16[0]) }
+#else
+#define OS_MPI_MEM_16               OS_MPI_NONE
+#endif
+
+#if (OS_MEMALLOC_32_NUM != 0)
+static uint64_t os_mem_32[OS_MEMALLOC_32_NUM][32/8] __attribute__((section(".bss.os.memalloc.mem")));
+#define OS_MPI_MEM_32               { &os_mem_class[1].info, &os_mem_32[0][0], OS_MEMALLOC_32_NUM, sizeof(os_mem_32[0]) }
+#else
+#define OS_MPI_MEM_32               OS_MPI_NONE
+#endif
+
+#if (OS_MEMALLOC_64_NUM != 0)
+static uint64_t os_mem_64[OS_MEMALLOC_64_NUM][64/8] __attribute__((section(".bss.os.memalloc.mem")));
+#define OS_MPI_MEM_64               { &os_mem_class[2].info, &os_mem_64[0][0], OS_MEMALLOC_64_NUM, sizeof(os_mem_64[0]) }
+#else
+#define OS_MPI_MEM_64               OS_MPI_NONE
+#endif
+
+#if (OS_MEMALLOC_128_NUM != 0)
+static uint64_t os_mem_128[OS_MEMALLOC_128_NUM][128/8] __attribute__((section(".bss.os.memalloc.mem")));
+#define OS_MPI_MEM_128              { &os_mem_class[3].info, &os_mem_128[0][0], OS_MEMALLOC_128_NUM, sizeof(os_mem_128[0]) }
+#else
+#define OS_MPI_MEM_128              OS_MPI_NONE
+#endif
+
+#if (OS_MEMALLOC_256_NUM != 0)
+static uint64_t os_mem_256[OS_MEMALLOC_256_NUM][256/8] __attribute__((section(".bss.os.memalloc.mem")));
+#define OS_MPI_MEM_256              { &os_mem_class[4].info, &os_mem_256[0][0], OS_MEMALLOC_256_NUM, sizeof(os_mem_256[0]) }
+#else
+#define OS_MPI_MEM_256              OS_MPI_NONE
+#endif
+
+#if (OS_MEMALLOC_512_NUM != 0)
+static uint64_t os_mem_512[OS_MEMALLOC_512_NUM][512/8] __attribute__((section(".bss.os.memalloc.mem")));
+#define OS_MPI_MEM_512              { &os_mem_class[5].info, &os_mem_512[0][0], OS_MEMALLOC_512_NUM, sizeof(os_mem_512[0]) }
+#else
+#define OS_MPI_MEM_512              OS_MPI_NONE
+#endif
+
+/* Kernel Heap */
+#if (OS_HEAP_SIZE != 0)
+static osHeap_t os_heap_cb __attribute__((section(".bss.os.heap.cb")));
+static uint64_t os_heap_mem[OS_HEAP_SIZE/8] __attribute__((section(".bss.os.heap.mem")));
+#endif
+
 /* Timer Semaphore Control Block */
 static osSemaphore_t os_timer_semaphore_cb __attribute__((section(".bss.os.semaphore.cb")));
 
@@ -92,12 +278,18 @@ const osConfig_t osConfig __USED __attribute__((section(".rodata"))) = {
   0U     // Flags
 #if (OS_PRIVILEGE_MODE != 0)
   | osConfigPrivilegedMode
+#if (OS_DIRECT_CALL != 0)
+  | osConfigDirectCall
+#endif
 #endif
 #if (OS_STACK_CHECK != 0)
   | osConfigStackCheck
 #endif
 #if (OS_STACK_WATERMARK != 0)
   | osConfigStackWatermark
+#endif
+#if (OS_THREAD_RUNTIME != 0)
+  | osConfigThreadRuntime
 #endif
   ,
   (uint32_t)OS_TICK_FREQ,
@@ -106,10 +298,46 @@ const osConfig_t osConfig __USED __attribute__((section(".rodata"))) = {
 #else
   0U,
 #endif
+  (uint32_t)OS_MUTEX_INHERIT_DEPTH,
   (uint32_t)MAX_API_INT_PRIO,
   &os_idle_thread_attr,
   &os_timer_thread_attr,
-  &os_timer_semaphore_attr
+  &os_timer_semaphore_attr,
+#if (OS_ISR_QUEUE_SIZE != 0)
+  { &os_isr_queue[0], (uint32_t)OS_ISR_QUEUE_SIZE },
+#else
+  { NULL, 0U },
+#endif
+  {
+    OS_MPI_STACK,
+    OS_MPI_THREAD,
+    OS_MPI_TIMER,
+    OS_MPI_EVFLAGS,
+    OS_MPI_MUTEX,
+    OS_MPI_SEMAPHORE,
+    OS_MPI_MEMPOOL,
+    OS_MPI_MEMPOOL_DATA,
+    OS_MPI_MSGQUEUE,
+    OS_MPI_MSGQUEUE_DATA,
+    OS_MPI_DATAQUEUE,
+    OS_MPI_DATAQUEUE_DATA,
+    OS_MPI_STREAMBUF,
+    OS_MPI_STREAMBUF_DATA
+  },
+  OS_MEM_CLASS,
+  {
+    OS_MPI_MEM_16,
+    OS_MPI_MEM_32,
+    OS_MPI_MEM_64,
+    OS_MPI_MEM_128,
+    OS_MPI_MEM_256,
+    OS_MPI_MEM_512
+  },
+#if (OS_HEAP_SIZE != 0)
+  { &os_heap_cb, &os_heap_mem[0], (uint32_t)sizeof(os_heap_mem) }
+#else
+  { NULL, NULL, 0U }
+#endif
 };
 
 /* Non weak reference to library irq module */
@@ -60,32 +60,106 @@
  *  function implementations (scope: module-local)
  ******************************************************************************/
 
+#if (ARCH_EXCLUSIVE_ACCESS != 0U)
+
+/**
+ * @brief       Acquire an available token without entering the kernel.
+ * @param[in]   sem   semaphore object.
+ * @return      true - token acquired, false - kernel call is required.
+ */
+static bool SemaphoreFastAcquire(osSemaphore_t *sem)
+{
+  uint16_t count;
+
+  if ((sem == NULL) || (sem->id != ID_SEMAPHORE)) {
+    return (false);
+  }
+
+  do {
+    count = __LDREXH(&sem->count);
+    if (count == 0U) {
+      __CLREX();
+      return (false);
+    }
+  } while (__STREXH((uint16_t)(count - 1U), &sem->count) != 0U);
+
+  return (true);
+}
+
+/**
+ * @brief       Release a token without entering the kernel when no Thread is waiting.
+ * @param[in]   sem   semaphore object.
+ * @return      true - token released, false - kernel call is required.
+ */
+static bool SemaphoreFastRelease(osSemaphore_t *sem)
+{
+  uint16_t count;
+
+  if ((sem == NULL) || (sem->id != ID_SEMAPHORE)) {
+    return (false);
+  }
+
+  /* Any exception between LDREX and STREX (a Thread starting to wait) fails the STREX */
+  do {
+    count = __LDREXH(&sem->count);
+    if ((count >= sem->max_count) || (*(volatile uint32_t *)&sem->wait_queue.bmp != 0U)) {
+      __CLREX();
+      return (false);
+    }
+  } while (__STREXH((uint16_t)(count + 1U), &sem->count) != 0U);
+
+  return (true);
+}
+
+#else
+
+#define SemaphoreFastAcquire(sem)     (false)
+#define SemaphoreFastRelease(sem)     (false)
+
+#endif
+
 static osSemaphoreId_t SemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
 {
   osSemaphore_t *sem;
+  const char    *name;
+  uint8_t        flags;
 
   /* Check parameters */
-  if ((attr == NULL)                          ||
-      (attr->cb_mem == NULL)                  ||
-      (((uint32_t)attr->cb_mem & 3U) != 0U)   ||
-      (attr->cb_size < sizeof(osSemaphore_t)) ||
-      (max_count == 0U)                       ||
-      (max_count > SemaphoreTokenLimit)       ||
-      (initial_count > max_count))
-  {
+  if ((max_count == 0U) || (max_count > SemaphoreTokenLimit) || (initial_count > max_count)) {
     return (NULL);
   }
 
-  sem = attr->cb_mem;
+  if (attr != NULL) {
+    name = attr->name;
+    sem  = attr->cb_mem;
+    if ((sem != NULL) && ((((uint32_t)sem & 3U) != 0U) || (attr->cb_size < sizeof(osSemaphore_t)))) {
+      return (NULL);
+    }
+  }
+  else {
+    name = NULL;
+    sem  = NULL;
+  }
+
+  flags = 0U;
+
+  /* Allocate control block from the Object Memory Pool */
+  if (sem == NULL) {
+    sem = libObjectAlloc(osObjectPoolSemaphore, sizeof(osSemaphore_t));
+    if (sem == NULL) {
+      return (NULL);
+    }
+    flags = osFlagSystemObject;
+  }
 
   /* Initialize control block */
   sem->id         = ID_SEMAPHORE;
-  sem->flags      = 0U;
-  sem->name       = attr->name;
+  sem->flags      = flags;
+  sem->name       = name;
   sem->count      = initial_count;
   sem->max_count  = max_count;
 
-  QueueReset(&sem->wait_queue);
+  WaitQueueReset(&sem->wait_queue);
 
   return (sem);
 }
@@ -154,9 +228,9 @@ static osStatus_t SemaphoreRelease(osSemaphoreId_t semaphore_id)
   BEGIN_CRITICAL_SECTION
 
   /* Check if Thread is waiting for a token */
-  if (!isQueueEmpty(&sem->wait_queue)) {
+  if (!isWaitQueueEmpty(&sem->wait_queue)) {
     /* Wakeup waiting Thread with highest Priority */
-    libThreadWaitExit(GetThreadByQueue(sem->wait_queue.next), (uint32_t)osOK, DISPATCH_YES);
+    libThreadWaitExit(WaitQueueHead(&sem->wait_queue), (uint32_t)osOK, DISPATCH_YES);
     status = osOK;
   }
   else {
@@ -175,6 +249,55 @@ static osStatus_t SemaphoreRelease(osSemaphoreId_t semaphore_id)
   return (status);
 }
 
+/**
+ * @brief       Wakeup Threads waiting for tokens released from ISR (executed by PendSV).
+ * @param[in]   object  semaphore object.
+ */
+static void SemaphorePostProcess(void *object)
+{
+  osSemaphore_t *sem = object;
+
+  /* Check object state */
+  if (sem->id != ID_SEMAPHORE) {
+    return;
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Pass released tokens to waiting Threads with highest Priority */
+  while ((sem->count != 0U) && !isWaitQueueEmpty(&sem->wait_queue)) {
+    sem->count--;
+    libThreadWaitExit(WaitQueueHead(&sem->wait_queue), (uint32_t)osOK, DISPATCH_NO);
+  }
+  libThreadDispatch(NULL);
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Release a token from ISR and defer waking of a waiting Thread.
+ * @param[in]   semaphore_id  semaphore ID obtained by \ref osSemaphoreNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+static osStatus_t isrSemaphoreRelease(osSemaphoreId_t semaphore_id)
+{
+  osSemaphore_t *sem = semaphore_id;
+
+  /* Check parameters */
+  if ((sem == NULL) || (sem->id != ID_SEMAPHORE)) {
+    return osErrorParameter;
+  }
+
+  /* Try to release token */
+  if (archAtomicIncLimit16(&sem->count, sem->max_count) >= sem->max_count) {
+    return osErrorResource;
+  }
+
+  libIsrQueuePut(SemaphorePostProcess, sem);
+
+  return osOK;
+}
+
 static uint32_t SemaphoreGetCount(osSemaphoreId_t semaphore_id)
 {
   osSemaphore_t *sem = semaphore_id;
@@ -201,6 +324,11 @@ static osStatus_t SemaphoreDelete(osSemaphoreId_t semaphore_id)
   /* Mark object as invalid */
   sem->id = ID_INVALID;
 
+  /* Free object memory */
+  if ((sem->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolSemaphore, sem);
+  }
+
   return (osOK);
 }
 
@@ -266,13 +394,19 @@ osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
       status = osErrorParameter;
     }
     else {
+      TraceEvent(osTraceIsrCall, (uint32_t)SemaphoreAcquire, (uint32_t)semaphore_id);
       status = SemaphoreAcquire(semaphore_id, timeout);
     }
   }
   else {
-    status = (osStatus_t)svc_2((uint32_t)semaphore_id, timeout, (uint32_t)SemaphoreAcquire);
-    if (status == osThreadWait) {
-      status = (osStatus_t)ThreadGetRunning()->winfo.ret_val;
+    if (SemaphoreFastAcquire(semaphore_id)) {
+      status = osOK;
+    }
+    else {
+      status = (osStatus_t)svc_2((uint32_t)semaphore_id, timeout, (uint32_t)SemaphoreAcquire);
+      if (status == osThreadWait) {
+        status = (osStatus_t)ThreadGetRunning()->winfo.ret_val;
+      }
     }
   }
 
@@ -290,7 +424,16 @@ osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id)
   osStatus_t status;
 
   if (IsIrqMode() || IsIrqMasked()) {
-    status = SemaphoreRelease(semaphore_id);
+    TraceEvent(osTraceIsrCall, (uint32_t)SemaphoreRelease, (uint32_t)semaphore_id);
+    if (IsIrqDeferred()) {
+      status = isrSemaphoreRelease(semaphore_id);
+    }
+    else {
+      status = SemaphoreRelease(semaphore_id);
+    }
+  }
+  else if (SemaphoreFastRelease(semaphore_id)) {
+    status = osOK;
   }
   else {
     status = (osStatus_t)svc_1((uint32_t)semaphore_id, (uint32_t)SemaphoreRelease);
@@ -313,7 +456,7 @@ uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id)
     count = SemaphoreGetCount(semaphore_id);
   }
   else {
-    count = svc_1((uint32_t)semaphore_id, (uint32_t)SemaphoreGetCount);
+    count = svc_read_1((uint32_t)semaphore_id, (uint32_t)SemaphoreGetCount);
   }
 
   return (count);
@@ -0,0 +1,1211 @@
+/*
+ * Copyright (C) 2019 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: uKernel real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Kernel system routines.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include <string.h>
+#include "os_lib.h"
+
+/*******************************************************************************
+ *  external declarations
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define MESSAGE_HEADER_SIZE         2U          /* Length prefix of a Message Buffer record */
+#define MESSAGE_SIZE_MAX            0xFFFFU
+
+#define isStreamObject(sb)          (((sb)->id == ID_STREAM_BUFFER) || ((sb)->id == ID_MESSAGE_BUFFER))
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions  (scope: module-exported)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+/**
+ * @brief       Copy up to size bytes into the ring buffer.
+ * @param[in]   sb        stream buffer object.
+ * @param[in]   data_ptr  pointer to buffer with data.
+ * @param[in]   size      number of bytes in the buffer.
+ * @return      number of bytes copied.
+ */
+static uint32_t StreamWrite(osStreamBuffer_t *sb, const uint8_t *data_ptr, uint32_t size)
+{
+  uint32_t span;
+
+  if (size > (sb->size - sb->count)) {
+    size = sb->size - sb->count;
+  }
+  if (size == 0U) {
+    return (0U);
+  }
+
+  /* Copy in at most two contiguous spans */
+  span = sb->size - sb->head;
+  if (span > size) {
+    span = size;
+  }
+  memcpy(&sb->sb_mem[sb->head], data_ptr, span);
+  if (span < size) {
+    memcpy(&sb->sb_mem[0], &data_ptr[span], size - span);
+  }
+
+  sb->head += size;
+  if (sb->head >= sb->size) {
+    sb->head -= sb->size;
+  }
+
+  sb->count += size;
+
+  return (size);
+}
+
+/**
+ * @brief       Copy up to size bytes out of the ring buffer.
+ * @param[in]   sb        stream buffer object.
+ * @param[out]  data_ptr  pointer to buffer for data.
+ * @param[in]   size      number of bytes the buffer can hold.
+ * @return      number of bytes copied.
+ */
+static uint32_t StreamRead(osStreamBuffer_t *sb, uint8_t *data_ptr, uint32_t size)
+{
+  uint32_t span;
+
+  if (size > sb->count) {
+    size = sb->count;
+  }
+  if (size == 0U) {
+    return (0U);
+  }
+
+  /* Copy out at most two contiguous spans */
+  span = sb->size - sb->tail;
+  if (span > size) {
+    span = size;
+  }
+  memcpy(data_ptr, &sb->sb_mem[sb->tail], span);
+  if (span < size) {
+    memcpy(&data_ptr[span], &sb->sb_mem[0], size - span);
+  }
+
+  sb->count -= size;
+  sb->tail += size;
+  if (sb->tail >= sb->size) {
+    sb->tail -= sb->size;
+  }
+
+  return (size);
+}
+
+/**
+ * @brief       Check if a reader asking for size bytes can be served.
+ * @param[in]   sb    stream buffer object.
+ * @param[in]   size  number of bytes requested by the reader.
+ * @return      true - trigger level (or the requested size) is reached.
+ */
+static
+bool StreamReadable(const osStreamBuffer_t *sb, uint32_t size)
+{
+  return ((sb->count >= ((size < sb->trigger) ? size : sb->trigger)) ? true : false);
+}
+
+/**
+ * @brief       Serve Threads waiting to read and write.
+ * @param[in]   sb  stream buffer object.
+ * @note        Readers get the number of bytes read as return value. Writers are woken
+ *              when all their bytes are written, the remaining size is kept in winfo.
+ */
+static void StreamBufferDispatch(osStreamBuffer_t *sb)
+{
+  osThread_t     *thread;
+  winfo_stream_t *winfo;
+  uint32_t        num;
+  bool            repeat;
+
+  do {
+    repeat = false;
+
+    while (!isWaitQueueEmpty(&sb->wait_get_queue)) {
+      /* Get waiting Thread with highest Priority */
+      thread = WaitQueueHead(&sb->wait_get_queue);
+      winfo = &thread->winfo.stream;
+      if (!StreamReadable(sb, winfo->size)) {
+        break;
+      }
+      num = StreamRead(sb, (uint8_t *)winfo->data_ptr, winfo->size);
+      libThreadWaitExit(thread, num, DISPATCH_NO);
+    }
+
+    while (!isWaitQueueEmpty(&sb->wait_put_queue) && (sb->count < sb->size)) {
+      /* Get waiting Thread with highest Priority */
+      thread = WaitQueueHead(&sb->wait_put_queue);
+      winfo = &thread->winfo.stream;
+      num = StreamWrite(sb, (const uint8_t *)winfo->data_ptr, winfo->size);
+      winfo->data_ptr += num;
+      winfo->size     -= num;
+      if (winfo->size != 0U) {
+        repeat = !isWaitQueueEmpty(&sb->wait_get_queue);
+        break;
+      }
+      libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
+      repeat = !isWaitQueueEmpty(&sb->wait_get_queue);
+    }
+  } while (repeat);
+}
+
+/**
+ * @brief       Get the size of the first record of a Message Buffer.
+ * @param[in]   sb  message buffer object (not empty).
+ * @return      message size in bytes.
+ */
+static uint32_t MessagePeekSize(const osStreamBuffer_t *sb)
+{
+  uint32_t next;
+
+  next = sb->tail + 1U;
+  if (next >= sb->size) {
+    next = 0U;
+  }
+
+  return ((uint32_t)sb->sb_mem[sb->tail] | ((uint32_t)sb->sb_mem[next] << 8));
+}
+
+/**
+ * @brief       Append a length-prefixed record to a Message Buffer.
+ * @param[in]   sb        message buffer object.
+ * @param[in]   msg_ptr   pointer to message.
+ * @param[in]   msg_size  message size in bytes (space is checked by the caller).
+ */
+static void MessageWrite(osStreamBuffer_t *sb, const void *msg_ptr, uint32_t msg_size)
+{
+  uint8_t header[MESSAGE_HEADER_SIZE];
+
+  header[0] = (uint8_t)msg_size;
+  header[1] = (uint8_t)(msg_size >> 8);
+  (void)StreamWrite(sb, header, MESSAGE_HEADER_SIZE);
+  (void)StreamWrite(sb, msg_ptr, msg_size);
+}
+
+/**
+ * @brief       Remove the first record from a Message Buffer.
+ * @param[in]   sb        message buffer object (not empty).
+ * @param[out]  msg_ptr   pointer to buffer for message.
+ * @param[in]   msg_size  message size obtained by MessagePeekSize.
+ */
+static void MessageRead(osStreamBuffer_t *sb, void *msg_ptr, uint32_t msg_size)
+{
+  uint8_t header[MESSAGE_HEADER_SIZE];
+
+  (void)StreamRead(sb, header, MESSAGE_HEADER_SIZE);
+  (void)StreamRead(sb, msg_ptr, msg_size);
+}
+
+/**
+ * @brief       Serve Threads waiting to receive and send records.
+ * @param[in]   sb  message buffer object.
+ * @note        Receivers get the message size as return value, or 0 if the message
+ *              does not fit into their buffer (it stays in the Message Buffer).
+ */
+static void MessageBufferDispatch(osStreamBuffer_t *sb)
+{
+  osThread_t     *thread;
+  winfo_stream_t *winfo;
+  uint32_t        msg_size;
+  bool            repeat;
+
+  do {
+    repeat = false;
+
+    while (!isWaitQueueEmpty(&sb->wait_get_queue) && (sb->count != 0U)) {
+      /* Get waiting Thread with highest Priority */
+      thread = WaitQueueHead(&sb->wait_get_queue);
+      winfo = &thread->winfo.stream;
+      msg_size = MessagePeekSize(sb);
+      if (msg_size <= winfo->size) {
+        MessageRead(sb, (void *)winfo->data_ptr, msg_size);
+      }
+      else {
+        msg_size = 0U;
+      }
+      libThreadWaitExit(thread, msg_size, DISPATCH_NO);
+    }
+
+    while (!isWaitQueueEmpty(&sb->wait_put_queue)) {
+      /* Get waiting Thread with highest Priority */
+      thread = WaitQueueHead(&sb->wait_put_queue);
+      winfo = &thread->winfo.stream;
+      if ((sb->size - sb->count) < (winfo->size + MESSAGE_HEADER_SIZE)) {
+        break;
+      }
+      MessageWrite(sb, (const void *)winfo->data_ptr, winfo->size);
+      libThreadWaitExit(thread, (uint32_t)osOK, DISPATCH_NO);
+      repeat = !isWaitQueueEmpty(&sb->wait_get_queue);
+    }
+  } while (repeat);
+}
+
+/**
+ * @brief       Serve waiting Threads of a Stream or Message Buffer.
+ * @param[in]   sb  stream buffer object.
+ */
+static void StreamBufferWakeup(osStreamBuffer_t *sb)
+{
+  if (sb->id == ID_MESSAGE_BUFFER) {
+    MessageBufferDispatch(sb);
+  }
+  else {
+    StreamBufferDispatch(sb);
+  }
+  libThreadDispatch(NULL);
+}
+
+/**
+ * @brief       Create a Stream or Message Buffer object.
+ * @param[in]   id              object identifier.
+ * @param[in]   size            buffer size in bytes.
+ * @param[in]   trigger_level   number of bytes that unblock a waiting reader.
+ * @param[in]   attr            stream buffer attributes.
+ * @return      stream buffer object or NULL in case of error.
+ */
+static osStreamBuffer_t *StreamBufferCreate(uint8_t id, uint32_t size, uint32_t trigger_level, const osStreamBufferAttr_t *attr)
+{
+  osStreamBuffer_t *sb;
+  void             *sb_mem;
+  const char       *name;
+  uint8_t           flags;
+
+  /* Check parameters */
+  if ((size == 0U) || (trigger_level > size)) {
+    return (NULL);
+  }
+
+  if (attr != NULL) {
+    name   = attr->name;
+    sb     = attr->cb_mem;
+    sb_mem = attr->sb_mem;
+    /* Check parameters */
+    if (((sb != NULL) && ((((uint32_t)sb & 3U) != 0U) || (attr->cb_size < sizeof(osStreamBuffer_t)))) ||
+        ((sb_mem != NULL) && (attr->sb_size < size))) {
+      return (NULL);
+    }
+  }
+  else {
+    name   = NULL;
+    sb     = NULL;
+    sb_mem = NULL;
+  }
+
+  flags = 0U;
+
+  /* Allocate control block and data storage from the Object Memory Pools */
+  if (sb == NULL) {
+    sb = libObjectAlloc(osObjectPoolStreamBuffer, sizeof(osStreamBuffer_t));
+    if (sb == NULL) {
+      return (NULL);
+    }
+    flags |= osFlagSystemObject;
+  }
+
+  if (sb_mem == NULL) {
+    sb_mem = libObjectAlloc(osObjectPoolStreamBufData, size);
+    if (sb_mem == NULL) {
+      if ((flags & osFlagSystemObject) != 0U) {
+        libObjectFree(osObjectPoolStreamBuffer, sb);
+      }
+      return (NULL);
+    }
+    flags |= osFlagSystemMemory;
+  }
+
+  /* Initialize control block */
+  sb->id      = id;
+  sb->flags   = flags;
+  sb->attr    = 0U;
+  sb->name    = name;
+  sb->size    = size;
+  sb->count   = 0U;
+  sb->trigger = (trigger_level != 0U) ? trigger_level : 1U;
+  sb->head    = 0U;
+  sb->tail    = 0U;
+  sb->sb_mem  = sb_mem;
+
+  WaitQueueReset(&sb->wait_put_queue);
+  WaitQueueReset(&sb->wait_get_queue);
+
+  return (sb);
+}
+
+static osStreamBufferId_t StreamBufferNew(uint32_t size, uint32_t trigger_level, const osStreamBufferAttr_t *attr)
+{
+  return (StreamBufferCreate(ID_STREAM_BUFFER, size, trigger_level, attr));
+}
+
+static const char *StreamBufferGetName(osStreamBufferId_t sb_id)
+{
+  osStreamBuffer_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || !isStreamObject(sb)) {
+    return (NULL);
+  }
+
+  return (sb->name);
+}
+
+static uint32_t StreamBufferSend(osStreamBufferId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  osStreamBuffer_t *sb = sb_id;
+  osThread_t       *thread;
+  uint32_t          num;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM_BUFFER) || (data_ptr == NULL) || (size == 0U)) {
+    return (0U);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Do not overtake blocked writers */
+  if (isWaitQueueEmpty(&sb->wait_put_queue)) {
+    num = StreamWrite(sb, data_ptr, size);
+    if ((num != 0U) && !isWaitQueueEmpty(&sb->wait_get_queue)) {
+      StreamBufferDispatch(sb);
+      libThreadDispatch(NULL);
+    }
+  }
+  else {
+    num = 0U;
+  }
+
+  if ((num < size) && (timeout != 0U)) {
+    /* Suspend current Thread until the rest is written */
+    thread = ThreadGetRunning();
+    if (libThreadWaitEnter(thread, &sb->wait_put_queue, timeout)) {
+      thread->winfo.stream.data_ptr = (uint32_t)data_ptr + num;
+      thread->winfo.stream.size     = size - num;
+      num = (uint32_t)osThreadWait;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (num);
+}
+
+/**
+ * @brief       Pass data written from ISR to waiting Threads (executed by PendSV).
+ * @param[in]   object  stream or message buffer object.
+ */
+static void StreamBufferPostProcess(void *object)
+{
+  osStreamBuffer_t *sb = object;
+
+  /* Check object state */
+  if (!isStreamObject(sb)) {
+    return;
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  StreamBufferWakeup(sb);
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Write bytes from ISR and defer waking of a waiting Thread.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamBufferNew.
+ * @param[in]   data_ptr  pointer to buffer with data to write.
+ * @param[in]   size      number of bytes to write.
+ * @return      number of bytes written.
+ */
+static uint32_t isrStreamBufferSend(osStreamBufferId_t sb_id, const void *data_ptr, uint32_t size)
+{
+  osStreamBuffer_t *sb = sb_id;
+  uint32_t          num;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM_BUFFER) || (data_ptr == NULL) || (size == 0U)) {
+    return (0U);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  num = isWaitQueueEmpty(&sb->wait_put_queue) ? StreamWrite(sb, data_ptr, size) : 0U;
+
+  END_CRITICAL_SECTION
+
+  if (num != 0U) {
+    libIsrQueuePut(StreamBufferPostProcess, sb);
+  }
+
+  return (num);
+}
+
+static uint32_t StreamBufferReceive(osStreamBufferId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  osStreamBuffer_t *sb = sb_id;
+  osThread_t       *thread;
+  uint32_t          num;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM_BUFFER) || (data_ptr == NULL) || (size == 0U)) {
+    return (0U);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  if ((timeout == 0U) || StreamReadable(sb, size)) {
+    num = StreamRead(sb, data_ptr, size);
+    if ((num != 0U) && !isWaitQueueEmpty(&sb->wait_put_queue)) {
+      StreamBufferDispatch(sb);
+      libThreadDispatch(NULL);
+    }
+  }
+  else {
+    num = 0U;
+    /* Suspend current Thread until the trigger level is reached */
+    thread = ThreadGetRunning();
+    if (libThreadWaitEnter(thread, &sb->wait_get_queue, timeout)) {
+      thread->winfo.stream.data_ptr = (uint32_t)data_ptr;
+      thread->winfo.stream.size     = size;
+      num = (uint32_t)osThreadWait;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (num);
+}
+
+static osStatus_t StreamBufferSetTriggerLevel(osStreamBufferId_t sb_id, uint32_t trigger_level)
+{
+  osStreamBuffer_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM_BUFFER) || (trigger_level > sb->size)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  sb->trigger = (trigger_level != 0U) ? trigger_level : 1U;
+
+  /* A lower level may release waiting readers */
+  if (!isWaitQueueEmpty(&sb->wait_get_queue)) {
+    StreamBufferDispatch(sb);
+    libThreadDispatch(NULL);
+  }
+
+  END_CRITICAL_SECTION
+
+  return (osOK);
+}
+
+static uint32_t StreamBufferGetCount(osStreamBufferId_t sb_id)
+{
+  osStreamBuffer_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM_BUFFER)) {
+    return (0U);
+  }
+
+  return (sb->count);
+}
+
+static uint32_t StreamBufferGetSpace(osStreamBufferId_t sb_id)
+{
+  osStreamBuffer_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_STREAM_BUFFER)) {
+    return (0U);
+  }
+
+  return (sb->size - sb->count);
+}
+
+static osStatus_t StreamBufferReset(osStreamBufferId_t sb_id)
+{
+  osStreamBuffer_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || !isStreamObject(sb)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Remove data from Buffer */
+  sb->count = 0U;
+  sb->head  = 0U;
+  sb->tail  = 0U;
+
+  /* Check if Threads are waiting to write data */
+  if (!isWaitQueueEmpty(&sb->wait_put_queue)) {
+    StreamBufferWakeup(sb);
+  }
+
+  END_CRITICAL_SECTION
+
+  return (osOK);
+}
+
+static osStatus_t StreamBufferDelete(osStreamBufferId_t sb_id)
+{
+  osStreamBuffer_t *sb = sb_id;
+
+  /* Check parameters */
+  if ((sb == NULL) || !isStreamObject(sb)) {
+    return (osErrorParameter);
+  }
+
+  /* Unblock waiting threads */
+  libThreadWaitDelete(&sb->wait_put_queue);
+  libThreadWaitDelete(&sb->wait_get_queue);
+
+  /* Mark object as invalid */
+  sb->id = ID_INVALID;
+
+  /* Free object memory */
+  if ((sb->flags & osFlagSystemMemory) != 0U) {
+    libObjectFree(osObjectPoolStreamBufData, sb->sb_mem);
+  }
+  if ((sb->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolStreamBuffer, sb);
+  }
+
+  return (osOK);
+}
+
+static osMessageBufferId_t MessageBufferNew(uint32_t size, const osMessageBufferAttr_t *attr)
+{
+  return (StreamBufferCreate(ID_MESSAGE_BUFFER, size, 0U, attr));
+}
+
+static osStatus_t MessageBufferSend(osMessageBufferId_t mb_id, const void *msg_ptr, uint32_t msg_size, uint32_t timeout)
+{
+  osStreamBuffer_t *sb = mb_id;
+  osThread_t       *thread;
+  osStatus_t        status;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_MESSAGE_BUFFER) || (msg_ptr == NULL) || (msg_size == 0U) ||
+      (msg_size > MESSAGE_SIZE_MAX) || (msg_size > (sb->size - MESSAGE_HEADER_SIZE)) || (sb->size < MESSAGE_HEADER_SIZE)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Do not overtake blocked senders */
+  if (isWaitQueueEmpty(&sb->wait_put_queue) && ((sb->size - sb->count) >= (msg_size + MESSAGE_HEADER_SIZE))) {
+    MessageWrite(sb, msg_ptr, msg_size);
+    if (!isWaitQueueEmpty(&sb->wait_get_queue)) {
+      StreamBufferWakeup(sb);
+    }
+    status = osOK;
+  }
+  else {
+    /* Not enough space for the record */
+    if (timeout != 0U) {
+      /* Suspend current Thread */
+      thread = ThreadGetRunning();
+      if (libThreadWaitEnter(thread, &sb->wait_put_queue, timeout)) {
+        thread->winfo.stream.data_ptr = (uint32_t)msg_ptr;
+        thread->winfo.stream.size     = msg_size;
+        status = (osStatus_t)osThreadWait;
+      }
+      else {
+        status = osErrorTimeout;
+      }
+    }
+    else {
+      status = osErrorResource;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (status);
+}
+
+/**
+ * @brief       Send a Message from ISR and defer waking of a waiting Thread.
+ * @param[in]   mb_id     message buffer ID obtained by \ref osMessageBufferNew.
+ * @param[in]   msg_ptr   pointer to message.
+ * @param[in]   msg_size  message size in bytes.
+ * @return      status code that indicates the execution status of the function.
+ */
+static osStatus_t isrMessageBufferSend(osMessageBufferId_t mb_id, const void *msg_ptr, uint32_t msg_size)
+{
+  osStreamBuffer_t *sb = mb_id;
+  osStatus_t        status;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_MESSAGE_BUFFER) || (msg_ptr == NULL) || (msg_size == 0U) ||
+      (msg_size > MESSAGE_SIZE_MAX) || (msg_size > (sb->size - MESSAGE_HEADER_SIZE)) || (sb->size < MESSAGE_HEADER_SIZE)) {
+    return (osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  if (isWaitQueueEmpty(&sb->wait_put_queue) && ((sb->size - sb->count) >= (msg_size + MESSAGE_HEADER_SIZE))) {
+    MessageWrite(sb, msg_ptr, msg_size);
+    status = osOK;
+  }
+  else {
+    status = osErrorResource;
+  }
+
+  END_CRITICAL_SECTION
+
+  if (status == osOK) {
+    libIsrQueuePut(StreamBufferPostProcess, sb);
+  }
+
+  return (status);
+}
+
+static uint32_t MessageBufferReceive(osMessageBufferId_t mb_id, void *msg_ptr, uint32_t size, uint32_t timeout)
+{
+  osStreamBuffer_t *sb = mb_id;
+  osThread_t       *thread;
+  uint32_t          msg_size;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_MESSAGE_BUFFER) || (msg_ptr == NULL)) {
+    return (0U);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  if (sb->count != 0U) {
+    msg_size = MessagePeekSize(sb);
+    if (msg_size <= size) {
+      MessageRead(sb, msg_ptr, msg_size);
+      if (!isWaitQueueEmpty(&sb->wait_put_queue)) {
+        StreamBufferWakeup(sb);
+      }
+    }
+    else {
+      /* Message does not fit into the buffer */
+      msg_size = 0U;
+    }
+  }
+  else {
+    msg_size = 0U;
+    if (timeout != 0U) {
+      /* Suspend current Thread */
+      thread = ThreadGetRunning();
+      if (libThreadWaitEnter(thread, &sb->wait_get_queue, timeout)) {
+        thread->winfo.stream.data_ptr = (uint32_t)msg_ptr;
+        thread->winfo.stream.size     = size;
+        msg_size = (uint32_t)osThreadWait;
+      }
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (msg_size);
+}
+
+static uint32_t MessageBufferGetNextSize(osMessageBufferId_t mb_id)
+{
+  osStreamBuffer_t *sb = mb_id;
+  uint32_t          msg_size;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_MESSAGE_BUFFER)) {
+    return (0U);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  msg_size = (sb->count != 0U) ? MessagePeekSize(sb) : 0U;
+
+  END_CRITICAL_SECTION
+
+  return (msg_size);
+}
+
+static uint32_t MessageBufferGetSpace(osMessageBufferId_t mb_id)
+{
+  osStreamBuffer_t *sb = mb_id;
+  uint32_t          space;
+
+  /* Check parameters */
+  if ((sb == NULL) || (sb->id != ID_MESSAGE_BUFFER)) {
+    return (0U);
+  }
+
+  space = sb->size - sb->count;
+  if (space <= MESSAGE_HEADER_SIZE) {
+    return (0U);
+  }
+  space -= MESSAGE_HEADER_SIZE;
+
+  return ((space > MESSAGE_SIZE_MAX) ? MESSAGE_SIZE_MAX : space);
+}
+
+/*******************************************************************************
+ *  Public API
+ ******************************************************************************/
+
+/**
+ * @fn          osStreamBufferId_t osStreamBufferNew(uint32_t size, uint32_t trigger_level, const osStreamBufferAttr_t *attr)
+ * @brief       Create and Initialize a Stream Buffer object.
+ * @param[in]   size            buffer size in bytes.
+ * @param[in]   trigger_level   number of bytes that unblock a waiting reader (0 - same as 1).
+ * @param[in]   attr            stream buffer attributes.
+ * @return      stream buffer ID for reference by other functions or NULL in case of error.
+ */
+osStreamBufferId_t osStreamBufferNew(uint32_t size, uint32_t trigger_level, const osStreamBufferAttr_t *attr)
+{
+  osStreamBufferId_t sb_id;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    sb_id = NULL;
+  }
+  else {
+    sb_id = (osStreamBufferId_t)svc_3(size, trigger_level, (uint32_t)attr, (uint32_t)StreamBufferNew);
+  }
+
+  return (sb_id);
+}
+
+/**
+ * @fn          const char *osStreamBufferGetName(osStreamBufferId_t sb_id)
+ * @brief       Get name of a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osStreamBufferGetName(osStreamBufferId_t sb_id)
+{
+  const char *name;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    name = NULL;
+  }
+  else {
+    name = (const char *)svc_1((uint32_t)sb_id, (uint32_t)StreamBufferGetName);
+  }
+
+  return (name);
+}
+
+/**
+ * @fn          uint32_t osStreamBufferSend(osStreamBufferId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Write bytes into a Stream Buffer or timeout if there is not enough space.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamBufferNew.
+ * @param[in]   data_ptr  pointer to buffer with data to write.
+ * @param[in]   size      number of bytes to write.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes written.
+ */
+uint32_t osStreamBufferSend(osStreamBufferId_t sb_id, const void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  uint32_t num;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      num = 0U;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)StreamBufferSend, (uint32_t)sb_id);
+      if (IsIrqDeferred()) {
+        num = isrStreamBufferSend(sb_id, data_ptr, size);
+      }
+      else {
+        num = StreamBufferSend(sb_id, data_ptr, size, timeout);
+      }
+    }
+  }
+  else {
+    num = svc_4((uint32_t)sb_id, (uint32_t)data_ptr, size, timeout, (uint32_t)StreamBufferSend);
+    if ((int32_t)num == osThreadWait) {
+      /* Written part is known also after a time-out */
+      num = size - ThreadGetRunning()->winfo.stream.size;
+    }
+  }
+
+  return (num);
+}
+
+/**
+ * @fn          uint32_t osStreamBufferReceive(osStreamBufferId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Read bytes from a Stream Buffer or timeout if less than the trigger level is stored.
+ * @param[in]   sb_id     stream buffer ID obtained by \ref osStreamBufferNew.
+ * @param[out]  data_ptr  pointer to buffer for data to read.
+ * @param[in]   size      maximum number of bytes to read.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      number of bytes read.
+ */
+uint32_t osStreamBufferReceive(osStreamBufferId_t sb_id, void *data_ptr, uint32_t size, uint32_t timeout)
+{
+  uint32_t num;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      num = 0U;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)StreamBufferReceive, (uint32_t)sb_id);
+      num = StreamBufferReceive(sb_id, data_ptr, size, timeout);
+    }
+  }
+  else {
+    num = svc_4((uint32_t)sb_id, (uint32_t)data_ptr, size, timeout, (uint32_t)StreamBufferReceive);
+    if ((int32_t)num == osThreadWait) {
+      num = ThreadGetRunning()->winfo.ret_val;
+      if ((osStatus_t)num == osErrorTimeout) {
+        /* Return the bytes below the trigger level */
+        num = svc_4((uint32_t)sb_id, (uint32_t)data_ptr, size, 0U, (uint32_t)StreamBufferReceive);
+      }
+      else if ((osStatus_t)num == osErrorResource) {
+        num = 0U;
+      }
+    }
+  }
+
+  return (num);
+}
+
+/**
+ * @fn          osStatus_t osStreamBufferSetTriggerLevel(osStreamBufferId_t sb_id, uint32_t trigger_level)
+ * @brief       Set the number of bytes that unblock a waiting reader.
+ * @param[in]   sb_id           stream buffer ID obtained by \ref osStreamBufferNew.
+ * @param[in]   trigger_level   trigger level in bytes (0 - same as 1).
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamBufferSetTriggerLevel(osStreamBufferId_t sb_id, uint32_t trigger_level)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_2((uint32_t)sb_id, trigger_level, (uint32_t)StreamBufferSetTriggerLevel);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          uint32_t osStreamBufferGetCount(osStreamBufferId_t sb_id)
+ * @brief       Get number of bytes stored in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      number of stored bytes.
+ */
+uint32_t osStreamBufferGetCount(osStreamBufferId_t sb_id)
+{
+  uint32_t count;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    count = StreamBufferGetCount(sb_id);
+  }
+  else {
+    count = svc_1((uint32_t)sb_id, (uint32_t)StreamBufferGetCount);
+  }
+
+  return (count);
+}
+
+/**
+ * @fn          uint32_t osStreamBufferGetSpace(osStreamBufferId_t sb_id)
+ * @brief       Get number of free bytes in a Stream Buffer.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      number of free bytes.
+ */
+uint32_t osStreamBufferGetSpace(osStreamBufferId_t sb_id)
+{
+  uint32_t space;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    space = StreamBufferGetSpace(sb_id);
+  }
+  else {
+    space = svc_1((uint32_t)sb_id, (uint32_t)StreamBufferGetSpace);
+  }
+
+  return (space);
+}
+
+/**
+ * @fn          osStatus_t osStreamBufferReset(osStreamBufferId_t sb_id)
+ * @brief       Reset a Stream Buffer to initial empty state.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamBufferReset(osStreamBufferId_t sb_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)sb_id, (uint32_t)StreamBufferReset);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osStreamBufferDelete(osStreamBufferId_t sb_id)
+ * @brief       Delete a Stream Buffer object.
+ * @param[in]   sb_id   stream buffer ID obtained by \ref osStreamBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osStreamBufferDelete(osStreamBufferId_t sb_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)sb_id, (uint32_t)StreamBufferDelete);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osMessageBufferId_t osMessageBufferNew(uint32_t size, const osMessageBufferAttr_t *attr)
+ * @brief       Create and Initialize a Message Buffer object.
+ * @param[in]   size    buffer size in bytes (each message takes its size plus 2 bytes).
+ * @param[in]   attr    message buffer attributes.
+ * @return      message buffer ID for reference by other functions or NULL in case of error.
+ */
+osMessageBufferId_t osMessageBufferNew(uint32_t size, const osMessageBufferAttr_t *attr)
+{
+  osMessageBufferId_t mb_id;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    mb_id = NULL;
+  }
+  else {
+    mb_id = (osMessageBufferId_t)svc_2(size, (uint32_t)attr, (uint32_t)MessageBufferNew);
+  }
+
+  return (mb_id);
+}
+
+/**
+ * @fn          const char *osMessageBufferGetName(osMessageBufferId_t mb_id)
+ * @brief       Get name of a Message Buffer object.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      name as null-terminated string or NULL in case of an error.
+ */
+const char *osMessageBufferGetName(osMessageBufferId_t mb_id)
+{
+  const char *name;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    name = NULL;
+  }
+  else {
+    name = (const char *)svc_1((uint32_t)mb_id, (uint32_t)StreamBufferGetName);
+  }
+
+  return (name);
+}
+
+/**
+ * @fn          osStatus_t osMessageBufferSend(osMessageBufferId_t mb_id, const void *msg_ptr, uint32_t msg_size, uint32_t timeout)
+ * @brief       Put a Message into a Message Buffer or timeout if there is not enough space.
+ * @param[in]   mb_id     message buffer ID obtained by \ref osMessageBufferNew.
+ * @param[in]   msg_ptr   pointer to message.
+ * @param[in]   msg_size  message size in bytes (1..65535).
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageBufferSend(osMessageBufferId_t mb_id, const void *msg_ptr, uint32_t msg_size, uint32_t timeout)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      status = osErrorParameter;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)MessageBufferSend, (uint32_t)mb_id);
+      if (IsIrqDeferred()) {
+        status = isrMessageBufferSend(mb_id, msg_ptr, msg_size);
+      }
+      else {
+        status = MessageBufferSend(mb_id, msg_ptr, msg_size, timeout);
+      }
+    }
+  }
+  else {
+    status = (osStatus_t)svc_4((uint32_t)mb_id, (uint32_t)msg_ptr, msg_size, timeout, (uint32_t)MessageBufferSend);
+    if (status == osThreadWait) {
+      status = (osStatus_t)ThreadGetRunning()->winfo.ret_val;
+    }
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          uint32_t osMessageBufferReceive(osMessageBufferId_t mb_id, void *msg_ptr, uint32_t size, uint32_t timeout)
+ * @brief       Get a Message from a Message Buffer or timeout if it is empty.
+ * @param[in]   mb_id     message buffer ID obtained by \ref osMessageBufferNew.
+ * @param[out]  msg_ptr   pointer to buffer for message.
+ * @param[in]   size      size of the buffer in bytes.
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      message size or 0 in case of no message or the message does not fit into the buffer.
+ */
+uint32_t osMessageBufferReceive(osMessageBufferId_t mb_id, void *msg_ptr, uint32_t size, uint32_t timeout)
+{
+  uint32_t msg_size;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    if (timeout != 0U) {
+      msg_size = 0U;
+    }
+    else {
+      TraceEvent(osTraceIsrCall, (uint32_t)MessageBufferReceive, (uint32_t)mb_id);
+      msg_size = MessageBufferReceive(mb_id, msg_ptr, size, timeout);
+    }
+  }
+  else {
+    msg_size = svc_4((uint32_t)mb_id, (uint32_t)msg_ptr, size, timeout, (uint32_t)MessageBufferReceive);
+    if ((int32_t)msg_size == osThreadWait) {
+      msg_size = ThreadGetRunning()->winfo.ret_val;
+      if (((osStatus_t)msg_size == osErrorTimeout) || ((osStatus_t)msg_size == osErrorResource)) {
+        msg_size = 0U;
+      }
+    }
+  }
+
+  return (msg_size);
+}
+
+/**
+ * @fn          uint32_t osMessageBufferGetNextSize(osMessageBufferId_t mb_id)
+ * @brief       Get size of the next Message in a Message Buffer.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      message size or 0 in case the Message Buffer is empty.
+ */
+uint32_t osMessageBufferGetNextSize(osMessageBufferId_t mb_id)
+{
+  uint32_t msg_size;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    msg_size = MessageBufferGetNextSize(mb_id);
+  }
+  else {
+    msg_size = svc_1((uint32_t)mb_id, (uint32_t)MessageBufferGetNextSize);
+  }
+
+  return (msg_size);
+}
+
+/**
+ * @fn          uint32_t osMessageBufferGetSpace(osMessageBufferId_t mb_id)
+ * @brief       Get size of the largest Message that can be put into a Message Buffer.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      message size in bytes.
+ */
+uint32_t osMessageBufferGetSpace(osMessageBufferId_t mb_id)
+{
+  uint32_t space;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    space = MessageBufferGetSpace(mb_id);
+  }
+  else {
+    space = svc_1((uint32_t)mb_id, (uint32_t)MessageBufferGetSpace);
+  }
+
+  return (space);
+}
+
+/**
+ * @fn          osStatus_t osMessageBufferReset(osMessageBufferId_t mb_id)
+ * @brief       Reset a Message Buffer to initial empty state.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageBufferReset(osMessageBufferId_t mb_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)mb_id, (uint32_t)StreamBufferReset);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osMessageBufferDelete(osMessageBufferId_t mb_id)
+ * @brief       Delete a Message Buffer object.
+ * @param[in]   mb_id   message buffer ID obtained by \ref osMessageBufferNew.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osMessageBufferDelete(osMessageBufferId_t mb_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)mb_id, (uint32_t)StreamBufferDelete);
+  }
+
+  return (status);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
@@ -30,10 +30,58 @@
 
 #include "os_lib.h"
 
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#define osThreadFlagsLimit    31U    ///< number of Thread Flags available per thread
+
 /*******************************************************************************
  *  Helper functions
  ******************************************************************************/
 
+/**
+ * @brief       Clear the object specific wait state of a thread leaving the wait state.
+ * @param[in]   thread    thread object.
+ */
+static void ThreadWaitCancel(osThread_t *thread)
+{
+  /* Stop waiting for Thread Flags */
+  thread->wait_flags = 0U;
+
+  /* Remove the thread from Event Flags wait list */
+  QueueRemoveEntry(&thread->flags_que);
+
+  /* Stop waiting for Thread termination */
+  if (thread->join_thread != NULL) {
+    thread->join_thread->thread_join = NULL;
+    thread->join_thread = NULL;
+  }
+}
+
+/**
+ * @brief       Update the object a thread stopped waiting for without being served.
+ * @param[in]   thread    thread object.
+ * @param[in]   wait_que  wait queue the thread has left.
+ */
+static void ThreadWaitAbort(osThread_t *thread, wait_queue_t *wait_que)
+{
+  osMutex_t *mutex = thread->wait_mutex;
+
+  if (wait_que == NULL) {
+    return;
+  }
+
+  /* Drop the priority inherited from the thread by the Mutex owners */
+  if ((mutex != NULL) && (wait_que == &mutex->wait_que)) {
+    libMutexWaitAbort(mutex);
+  }
+  /* The head of the heap wait queue may have changed */
+  else if ((osConfig.heap.cb != NULL) && (wait_que == &osConfig.heap.cb->wait_queue)) {
+    libHeapWaitAbort();
+  }
+}
+
 static void ThreadStackInit(uint32_t func_addr, void *func_param, osThread_t *thread)
 {
   uint32_t *stk = (uint32_t *)((uint32_t)thread->stk_mem + thread->stk_size);
@@ -46,6 +94,9 @@ static void ThreadStackInit(uint32_t func_addr, void *func_param, osThread_t *th
   *(--stk) = 0x02020202L;                       //-- R2
   *(--stk) = 0x01010101L;                       //-- R1
   *(--stk) = (uint32_t)func_param;              //-- R0 - thread's function argument
+#if (ARCH_FPU_USED != 0U)
+  *(--stk) = INITIAL_EXC_RETURN;                //-- EXC_RETURN (restored by PendSV)
+#endif
   *(--stk) = 0x11111111L;                       //-- R11
   *(--stk) = 0x10101010L;                       //-- R10
   *(--stk) = 0x09090909L;                       //-- R9
@@ -92,6 +143,67 @@ static void ThreadReadyDel(osThread_t *thread)
   }
 }
 
+/**
+ * @brief       Adds thread to the end of wait queue for current priority
+ * @param[in]   thread
+ * @param[out]  wait_que  Pointer to wait queue.
+ */
+static void ThreadWaitAdd(osThread_t *thread, wait_queue_t *wait_que)
+{
+  int8_t priority = thread->priority - 1U;
+
+  thread->wait_queue = wait_que;
+  QueueAppend(&wait_que->list[priority], &thread->thread_que);
+  wait_que->bmp |= (1UL << priority);
+}
+
+/**
+ * @brief       Deletes thread from the wait queue it is blocked on (if any)
+ * @param[in]   thread
+ */
+static void ThreadWaitDel(osThread_t *thread)
+{
+  wait_queue_t *wait_que = thread->wait_queue;
+  int8_t        priority = thread->priority - 1U;
+
+  if (wait_que == NULL) {
+    return;
+  }
+
+  /* Remove the thread from wait queue */
+  QueueRemoveEntry(&thread->thread_que);
+  thread->wait_queue = NULL;
+
+  if (isQueueEmpty(&wait_que->list[priority])) {
+    /* No waiting threads for the current priority */
+    wait_que->bmp &= ~(1UL << priority);
+  }
+}
+
+/**
+ * @brief       Check the Thread Flags of a thread and clear them if requested.
+ * @param[in]   thread    thread object.
+ * @param[in]   flags     specifies the flags to check for.
+ * @param[in]   options   specifies flags options (osFlagsXxxx).
+ * @return      thread flags before clearing or 0 if the wait condition is not met.
+ */
+static uint32_t ThreadFlagsCheck(osThread_t *thread, uint32_t flags, uint32_t options)
+{
+  uint32_t pattern = thread->thread_flags;
+
+  if ((((options & osFlagsWaitAll) != 0U) && ((pattern & flags) != flags)) ||
+      (((options & osFlagsWaitAll) == 0U) && ((pattern & flags) == 0U)))
+  {
+    return (0U);
+  }
+
+  if ((options & osFlagsNoClear) == 0U) {
+    thread->thread_flags &= ~flags;
+  }
+
+  return (pattern);
+}
+
 /*******************************************************************************
  *  Service Calls
  ******************************************************************************/
@@ -102,23 +214,41 @@ static osThreadId_t ThreadNew(osThreadFunc_t func, void *argument, const osThrea
   void         *stack_mem;
   uint32_t      stack_size;
   osPriority_t  priority;
+  const char   *name;
+  uint32_t      attr_bits;
+  uint32_t      time_slice;
+  uint8_t       flags;
 
-  if ((func == NULL) || (attr == NULL)) {
+  if (func == NULL) {
     return (NULL);
   }
 
-  thread = attr->cb_mem;
-  stack_mem = attr->stack_mem;
-  stack_size = attr->stack_size;
-  priority = attr->priority;
+  if (attr != NULL) {
+    name       = attr->name;
+    attr_bits  = attr->attr_bits;
+    thread     = attr->cb_mem;
+    stack_mem  = attr->stack_mem;
+    stack_size = attr->stack_size;
+    priority   = attr->priority;
+    time_slice = attr->time_slice;
 
-  if ((thread == NULL) || (attr->cb_size < sizeof(osThread_t))) {
-    return (NULL);
-  }
+    if ((thread != NULL) && ((((uint32_t)thread & 3U) != 0U) || (attr->cb_size < sizeof(osThread_t)))) {
+      return (NULL);
+    }
 
-  if ((stack_mem == NULL) || (((uint32_t)stack_mem & 7U) != 0U) ||
-      (stack_size < 64U)  || ((stack_size & 7U) != 0U)            ) {
-    return (NULL);
+    if ((stack_mem != NULL) &&
+        ((((uint32_t)stack_mem & 7U) != 0U) || (stack_size < 64U) || ((stack_size & 7U) != 0U))) {
+      return (NULL);
+    }
+  }
+  else {
+    name       = NULL;
+    attr_bits  = 0U;
+    thread     = NULL;
+    stack_mem  = NULL;
+    stack_size = 0U;
+    priority   = osPriorityNone;
+    time_slice = 0U;
   }
 
   if (priority == osPriorityNone) {
@@ -128,18 +258,57 @@ static osThreadId_t ThreadNew(osThreadFunc_t func, void *argument, const osThrea
     return (NULL);
   }
 
+  flags = 0U;
+
+  /* Allocate control block and stack from the Object Memory Pools */
+  if (thread == NULL) {
+    thread = libObjectAlloc(osObjectPoolThread, sizeof(osThread_t));
+    if (thread == NULL) {
+      return (NULL);
+    }
+    flags |= osFlagSystemObject;
+  }
+
+  if (stack_mem == NULL) {
+    stack_mem = libObjectAlloc(osObjectPoolStack, stack_size);
+    if (stack_mem == NULL) {
+      if ((flags & osFlagSystemObject) != 0U) {
+        libObjectFree(osObjectPoolThread, thread);
+      }
+      return (NULL);
+    }
+    stack_size = osConfig.mpi[osObjectPoolStack].size;
+    flags |= osFlagSystemMemory;
+  }
+
   /* Init thread control block */
   thread->stk_mem       = stack_mem;
   thread->stk_size      = stack_size;
   thread->base_priority = (int8_t)priority;
   thread->priority      = (int8_t)priority;
   thread->id            = ID_THREAD;
-  thread->name          = attr->name;
-  thread->delay         = 0U;
+  thread->flags         = flags;
+  thread->attr          = (uint8_t)(attr_bits & osThreadJoinable);
+  thread->name          = name;
+  thread->wait_queue    = NULL;
+  thread->time_slice    = (time_slice != 0U) ? time_slice : osConfig.robin_timeout;
+  thread->slice_left    = thread->time_slice;
+
+  thread->runtime.cycles     = 0U;
+  thread->runtime.switch_in  = 0U;
+  thread->runtime.switch_out = 0U;
+  thread->runtime.last_run   = 0U;
+
+  thread->thread_flags  = 0U;
+  thread->wait_flags    = 0U;
+  thread->wait_mutex    = NULL;
+  thread->thread_join   = NULL;
+  thread->join_thread   = NULL;
 
   QueueReset(&thread->thread_que);
-  QueueReset(&thread->delay_que);
+  QueueReset(&thread->flags_que);
   QueueReset(&thread->mutex_que);
+  TimeoutReset(&thread->delay, ID_THREAD);
 
   /* Fill all thread stack space by FILL_STACK_VAL */
   uint32_t *ptr = stack_mem;
@@ -226,6 +395,25 @@ uint32_t ThreadGetStackSpace(osThreadId_t thread_id)
   return (space);
 }
 
+static osStatus_t ThreadGetRuntime(osThreadId_t thread_id, osThreadRuntime_t *runtime)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD) || (runtime == NULL)) {
+    return (osErrorParameter);
+  }
+
+  if ((osConfig.flags & osConfigThreadRuntime) == 0U) {
+    return (osError);
+  }
+
+  libThreadRuntimeUpdate();
+  *runtime = thread->runtime;
+
+  return (osOK);
+}
+
 static osStatus_t ThreadSetPriority(osThreadId_t thread_id, osPriority_t priority)
 {
   osThread_t *thread = (osThread_t *)thread_id;
@@ -296,8 +484,9 @@ static osStatus_t ThreadYield(void)
 static
 osStatus_t ThreadSuspend(osThreadId_t thread_id)
 {
-  osThread_t *thread = (osThread_t *)thread_id;
-  osStatus_t status = osOK;
+  osThread_t   *thread = (osThread_t *)thread_id;
+  wait_queue_t *wait_que;
+  osStatus_t    status = osOK;
 
   /* Check parameters */
   if ((thread == NULL) || (thread->id != ID_THREAD)) {
@@ -324,10 +513,14 @@ osStatus_t ThreadSuspend(osThreadId_t thread_id)
       break;
 
     case ThreadStateBlocked:
-      /* Remove the thread from delay queue */
-      QueueRemoveEntry(&thread->delay_que);
+      /* Remove the thread from timing wheel */
+      libTimeoutRemove(&thread->delay);
       /* Remove the thread from wait queue */
-      QueueRemoveEntry(&thread->thread_que);
+      wait_que = thread->wait_queue;
+      ThreadWaitDel(thread);
+      ThreadWaitCancel(thread);
+      ThreadWaitAbort(thread, wait_que);
+      libThreadDispatch(NULL);
       break;
 
     case ThreadStateTerminated:
@@ -355,11 +548,126 @@ static osStatus_t ThreadResume(osThreadId_t thread_id)
   }
 
   /* Wakeup Thread */
-  libThreadWaitExit(thread, (uint32_t)osErrorTimeout, DISPATCH_YES);
+  libThreadWaitTimeout(thread, DISPATCH_YES);
 
   return (osOK);
 }
 
+static void ThreadFree(osThread_t *thread)
+{
+  if ((thread->flags & osFlagSystemMemory) != 0U) {
+    libObjectFree(osObjectPoolStack, thread->stk_mem);
+  }
+  if ((thread->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolThread, thread);
+  }
+}
+
+/**
+ * @brief       Release a thread object that is no longer executed.
+ * @param[in]   thread    thread object.
+ */
+static void ThreadRelease(osThread_t *thread)
+{
+  thread->state = ThreadStateInactive;
+  thread->id = ID_INVALID;
+
+  if (thread->flags != 0U) {
+    if (thread == ThreadGetRunning()) {
+      /* Context of the thread must not be saved into the released memory */
+      osInfo.thread.run.curr = NULL;
+    }
+    ThreadFree(thread);
+  }
+}
+
+/**
+ * @brief       Finish a thread that was removed from the ready and wait lists.
+ * @param[in]   thread    thread object.
+ */
+static void ThreadDestroy(osThread_t *thread)
+{
+  osThread_t *thread_join = thread->thread_join;
+
+  /* Release owned Mutexes */
+  libMutexOwnerRelease(&thread->mutex_que);
+
+  if (thread_join != NULL) {
+    /* Wakeup Thread waiting to Join */
+    libThreadWaitExit(thread_join, (uint32_t)osOK, DISPATCH_NO);
+  }
+  else if ((thread->attr & osThreadJoinable) != 0U) {
+    /* Keep the thread object until it is joined or detached */
+    thread->state = ThreadStateTerminated;
+    return;
+  }
+
+  ThreadRelease(thread);
+}
+
+static osStatus_t ThreadDetach(osThreadId_t thread_id)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD)) {
+    return (osErrorParameter);
+  }
+
+  /* Check object attributes */
+  if ((thread->attr & osThreadJoinable) == 0U) {
+    return (osErrorResource);
+  }
+
+  if (thread->state == ThreadStateTerminated) {
+    ThreadRelease(thread);
+  }
+  else {
+    thread->attr &= ~osThreadJoinable;
+
+    if (thread->thread_join != NULL) {
+      /* Thread waiting to Join is released with an error */
+      libThreadWaitExit(thread->thread_join, (uint32_t)osErrorResource, DISPATCH_YES);
+    }
+  }
+
+  return (osOK);
+}
+
+static osStatus_t ThreadJoin(osThreadId_t thread_id)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+  osThread_t *thread_running;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD)) {
+    return (osErrorParameter);
+  }
+
+  thread_running = ThreadGetRunning();
+
+  /* Check object attributes and state */
+  if (((thread->attr & osThreadJoinable) == 0U) ||
+      (thread->thread_join != NULL) || (thread == thread_running)) {
+    return (osErrorResource);
+  }
+
+  if (thread->state == ThreadStateTerminated) {
+    ThreadRelease(thread);
+    return (osOK);
+  }
+
+  /* Suspend current Thread until the thread terminates */
+  if (!libThreadWaitEnter(thread_running, NULL, osWaitForever)) {
+    return (osErrorResource);
+  }
+
+  thread->thread_join = thread_running;
+  thread_running->join_thread = thread;
+
+  return ((osStatus_t)osThreadWait);
+}
+
 static void ThreadExit(void)
 {
   osThread_t *thread;
@@ -371,19 +679,17 @@ static void ThreadExit(void)
 
   thread = ThreadGetRunning();
 
-  /* Release owned Mutexes */
-  libMutexOwnerRelease(&thread->mutex_que);
-
   ThreadReadyDel(thread);
+  ThreadDestroy(thread);
   libThreadSwitch(libThreadHighestPrioGet());
-  thread->state = ThreadStateInactive;
-  thread->id = ID_INVALID;
 }
 
 static osStatus_t ThreadTerminate(osThreadId_t thread_id)
 {
-  osThread_t *thread = (osThread_t *)thread_id;
-  osStatus_t status = osOK;
+  osThread_t   *thread = (osThread_t *)thread_id;
+  wait_queue_t *wait_que;
+  osStatus_t    status = osOK;
+  bool          running = false;
 
   /* Check parameters */
   if ((thread == NULL) || (thread->id != ID_THREAD)) {
@@ -399,6 +705,7 @@ static osStatus_t ThreadTerminate(osThreadId_t thread_id)
       }
       else {
         ThreadReadyDel(thread);
+        running = true;
       }
       break;
 
@@ -407,10 +714,13 @@ static osStatus_t ThreadTerminate(osThreadId_t thread_id)
       break;
 
     case ThreadStateBlocked:
-      /* Remove the thread from delay queue */
-      QueueRemoveEntry(&thread->delay_que);
+      /* Remove the thread from timing wheel */
+      libTimeoutRemove(&thread->delay);
       /* Remove the thread from wait queue */
-      QueueRemoveEntry(&thread->thread_que);
+      wait_que = thread->wait_queue;
+      ThreadWaitDel(thread);
+      ThreadWaitCancel(thread);
+      ThreadWaitAbort(thread, wait_que);
       break;
 
     case ThreadStateInactive:
@@ -421,18 +731,14 @@ static osStatus_t ThreadTerminate(osThreadId_t thread_id)
   }
 
   if (status == osOK) {
-    /* Release owned Mutexes */
-    libMutexOwnerRelease(&thread->mutex_que);
+    ThreadDestroy(thread);
 
-    if (thread->state == ThreadStateRunning) {
+    if (running) {
       libThreadSwitch(libThreadHighestPrioGet());
     }
     else {
       libThreadDispatch(NULL);
     }
-
-    thread->state = ThreadStateInactive;
-    thread->id = ID_INVALID;
   }
 
   return (status);
@@ -451,6 +757,174 @@ static uint32_t ThreadEnumerate(osThreadId_t *thread_array, uint32_t array_items
   return (0U);
 }
 
+/**
+ * @brief       Wakeup a Thread if its Thread Flags wait condition is met.
+ * @param[in]   thread    thread object.
+ */
+static void ThreadFlagsWakeup(osThread_t *thread)
+{
+  uint32_t pattern;
+
+  if (thread->wait_flags != 0U) {
+    pattern = ThreadFlagsCheck(thread, thread->wait_flags, thread->winfo.event.options);
+    if (pattern != 0U) {
+      libThreadWaitExit(thread, pattern, DISPATCH_YES);
+    }
+  }
+}
+
+static uint32_t ThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+  uint32_t    thread_flags;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD) ||
+      (flags == 0U) || ((flags & (1UL << osThreadFlagsLimit)) != 0U))
+  {
+    return ((uint32_t)osErrorParameter);
+  }
+
+  /* Check object state */
+  if ((thread->state == ThreadStateInactive) || (thread->state == ThreadStateTerminated)) {
+    return ((uint32_t)osErrorResource);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  /* Set Thread Flags */
+  thread->thread_flags |= flags;
+
+  /* Wakeup the thread if it waits for the flags */
+  ThreadFlagsWakeup(thread);
+  thread_flags = thread->thread_flags;
+
+  END_CRITICAL_SECTION
+
+  return (thread_flags);
+}
+
+/**
+ * @brief       Wakeup a Thread waiting for Thread Flags set from ISR (executed by PendSV).
+ * @param[in]   object  thread object.
+ */
+static void ThreadFlagsPostProcess(void *object)
+{
+  osThread_t *thread = object;
+
+  /* Check object state */
+  if (thread->id != ID_THREAD) {
+    return;
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  ThreadFlagsWakeup(thread);
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Set Thread Flags from ISR and defer waking of the Thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   flags       specifies the flags of the thread that shall be set.
+ * @return      thread flags after setting or error code if highest bit set.
+ */
+static uint32_t isrThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+  osThread_t *thread = (osThread_t *)thread_id;
+  uint32_t    thread_flags;
+
+  /* Check parameters */
+  if ((thread == NULL) || (thread->id != ID_THREAD) ||
+      (flags == 0U) || ((flags & (1UL << osThreadFlagsLimit)) != 0U))
+  {
+    return ((uint32_t)osErrorParameter);
+  }
+
+  /* Check object state */
+  if ((thread->state == ThreadStateInactive) || (thread->state == ThreadStateTerminated)) {
+    return ((uint32_t)osErrorResource);
+  }
+
+  /* Set Thread Flags */
+  thread_flags = archAtomicSetBits(&thread->thread_flags, flags);
+
+  libIsrQueuePut(ThreadFlagsPostProcess, thread);
+
+  return (thread_flags);
+}
+
+static uint32_t ThreadFlagsClear(uint32_t flags)
+{
+  osThread_t *thread = ThreadGetRunning();
+  uint32_t    thread_flags;
+
+  /* Check parameters */
+  if ((thread == NULL) ||
+      (flags == 0U) || ((flags & (1UL << osThreadFlagsLimit)) != 0U))
+  {
+    return ((uint32_t)osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  thread_flags = thread->thread_flags;
+  thread->thread_flags &= ~flags;
+
+  END_CRITICAL_SECTION
+
+  return (thread_flags);
+}
+
+static uint32_t ThreadFlagsGet(void)
+{
+  osThread_t *thread = ThreadGetRunning();
+
+  if (thread == NULL) {
+    return (0U);
+  }
+
+  return (thread->thread_flags);
+}
+
+static uint32_t ThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  osThread_t *thread = ThreadGetRunning();
+  uint32_t    thread_flags;
+
+  /* Check parameters */
+  if ((thread == NULL) ||
+      (flags == 0U) || ((flags & (1UL << osThreadFlagsLimit)) != 0U))
+  {
+    return ((uint32_t)osErrorParameter);
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  thread_flags = ThreadFlagsCheck(thread, flags, options);
+
+  if (thread_flags == 0U) {
+    if (timeout != 0U) {
+      if (libThreadWaitEnter(thread, NULL, timeout)) {
+        thread->wait_flags = flags;
+        thread->winfo.event.options = options;
+        thread_flags = (uint32_t)osThreadWait;
+      }
+      else {
+        thread_flags = (uint32_t)osErrorTimeout;
+      }
+    }
+    else {
+      thread_flags = (uint32_t)osErrorResource;
+    }
+  }
+
+  END_CRITICAL_SECTION
+
+  return (thread_flags);
+}
+
 /*******************************************************************************
  *  Library functions
  ******************************************************************************/
@@ -491,10 +965,14 @@ void libThreadWaitExit(osThread_t *thread, uint32_t ret_val, dispatch_t dispatch
 {
   BEGIN_CRITICAL_SECTION
 
+  TraceEvent(osTraceThreadWakeup, (uint32_t)thread, ret_val);
+
   thread->winfo.ret_val = ret_val;
+  ThreadWaitCancel(thread);
 
-  /* Remove the thread from delay queue */
-  QueueRemoveEntry(&thread->delay_que);
+  /* Remove the thread from timing wheel */
+  libTimeoutRemove(&thread->delay);
+  ThreadWaitDel(thread);
   ThreadReadyAdd(thread);
   if (dispatch != DISPATCH_NO) {
     libThreadDispatch(thread);
@@ -503,46 +981,53 @@ void libThreadWaitExit(osThread_t *thread, uint32_t ret_val, dispatch_t dispatch
   END_CRITICAL_SECTION
 }
 
+/**
+ * @brief       Exit Thread wait state on timeout or resume without being served.
+ * @param[out]  thread    thread object.
+ * @param[in]   dispatch  dispatch the highest priority Ready Thread.
+ */
+void libThreadWaitTimeout(osThread_t *thread, dispatch_t dispatch)
+{
+  wait_queue_t *wait_que;
+
+  BEGIN_CRITICAL_SECTION
+
+  wait_que = thread->wait_queue;
+  libThreadWaitExit(thread, (uint32_t)osErrorTimeout, DISPATCH_NO);
+  ThreadWaitAbort(thread, wait_que);
+  if (dispatch != DISPATCH_NO) {
+    libThreadDispatch(NULL);
+  }
+
+  END_CRITICAL_SECTION
+}
+
 /**
  * @brief       Enter Thread wait state.
  * @param[out]  thread    thread object.
  * @param[out]  wait_que  Pointer to wait queue.
  * @param[in]   timeout   Timeout
  */
-bool libThreadWaitEnter(osThread_t *thread, queue_t *wait_que, uint32_t timeout)
+bool libThreadWaitEnter(osThread_t *thread, wait_queue_t *wait_que, uint32_t timeout)
 {
-  queue_t *que;
-  queue_t *delay_queue;
-
   if (osInfo.kernel.state != osKernelRunning) {
     return (false);
   }
 
+  TraceEvent(osTraceThreadWait, (uint32_t)thread, timeout);
+
   ThreadReadyDel(thread);
 
   thread->state = ThreadStateBlocked;
 
   /* Add to the wait queue */
   if (wait_que != NULL) {
-    for (que = wait_que->next; que != wait_que; que = que->next) {
-      if (thread->priority > GetThreadByQueue(que)->priority) {
-        break;
-      }
-    }
-    QueueAppend(que, &thread->thread_que);
+    ThreadWaitAdd(thread, wait_que);
   }
 
-  /* Add to the delay queue */
+  /* Add to the timing wheel */
   if (timeout != osWaitForever) {
-    thread->delay = osInfo.kernel.tick + timeout;
-    delay_queue = &osInfo.delay_queue;
-    for (que = delay_queue->next; que != delay_queue; que = que->next) {
-      if (time_before(thread->delay, GetThreadByDelayQueue(que)->delay)) {
-        break;
-      }
-    }
-
-    QueueAppend(que, &thread->delay_que);
+    libTimeoutInsert(&thread->delay, osInfo.kernel.tick + timeout);
   }
 
   thread = libThreadHighestPrioGet();
@@ -552,38 +1037,103 @@ bool libThreadWaitEnter(osThread_t *thread, queue_t *wait_que, uint32_t timeout)
 }
 
 /**
- * @brief
- * @param wait_que
+ * @brief       Release all Threads waiting in the wait queue.
+ * @param[out]  wait_que  Pointer to wait queue.
  */
-void libThreadWaitDelete(queue_t *wait_que)
+void libThreadWaitDelete(wait_queue_t *wait_que)
 {
-  while (!isQueueEmpty(wait_que)) {
-    libThreadWaitExit(GetThreadByQueue(wait_que->next), (uint32_t)osErrorResource, DISPATCH_NO);
+  while (!isWaitQueueEmpty(wait_que)) {
+    libThreadWaitExit(WaitQueueHead(wait_que), (uint32_t)osErrorResource, DISPATCH_NO);
   }
   libThreadDispatch(NULL);
 }
 
 /**
- * @brief       Process Thread Delay Tick (executed each System Tick).
+ * @brief       Process Round-Robin Time Slice of the running Thread (executed each System Tick).
  */
-bool libThreadDelayTick(void)
+void libThreadRobinTick(void)
 {
   osThread_t *thread;
-  bool        result = false;
-  queue_t    *delay_queue = &osInfo.delay_queue;
+  queue_t    *que;
 
-  while (!isQueueEmpty(delay_queue)) {
-    thread = GetThreadByDelayQueue(delay_queue->next);
-    if (time_after(thread->delay, osInfo.kernel.tick)) {
-      break;
-    }
-    else {
-      libThreadWaitExit(thread, (uint32_t)osErrorTimeout, DISPATCH_NO);
-      result = true;
-    }
+  thread = ThreadGetRunning();
+
+  /* Skip if a Thread switch is already pending */
+  if ((osInfo.kernel.state != osKernelRunning) ||
+      (thread == NULL) || (osInfo.thread.run.next != thread) ||
+      (thread->state != ThreadStateRunning) || (thread->time_slice == 0U)) {
+    return;
+  }
+
+  if (--thread->slice_left != 0U) {
+    return;
+  }
+
+  thread->slice_left = thread->time_slice;
+
+  que = &osInfo.ready_list[thread->priority - 1U];
+
+  /* Check if other Threads with the same priority are ready */
+  if (que->next != que->prev) {
+    /* Move the running Thread to the end of ready queue */
+    QueueRemoveEntry(&thread->thread_que);
+    QueueAppend(que, &thread->thread_que);
+    thread->state = ThreadStateReady;
+    libThreadSwitch(GetThreadByQueue(que->next));
+  }
+}
+
+/**
+ * @brief       Account the time elapsed since the last accounting to the running Thread.
+ */
+void libThreadRuntimeUpdate(void)
+{
+  osThread_t *thread;
+  uint32_t    stamp;
+  uint32_t    delta;
+
+  if ((osConfig.flags & osConfigThreadRuntime) == 0U) {
+    return;
+  }
+
+  BEGIN_CRITICAL_SECTION
+
+  stamp = archCycleCounterGet(osInfo.kernel.tick);
+  delta = stamp - osInfo.runtime.stamp;
+  osInfo.runtime.stamp  = stamp;
+  osInfo.runtime.total += delta;
+
+  thread = ThreadGetRunning();
+  if (thread != NULL) {
+    thread->runtime.cycles += delta;
+  }
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Account the Thread switch in runtime statistics and trace (executed by PendSV before the switch).
+ */
+void libThreadRuntimeSwitch(void)
+{
+  osThread_t *thread;
+
+  TraceEvent(osTraceThreadSwitch, (uint32_t)ThreadGetRunning(), (uint32_t)osInfo.thread.run.next);
+
+  if ((osConfig.flags & osConfigThreadRuntime) == 0U) {
+    return;
+  }
+
+  libThreadRuntimeUpdate();
+
+  thread = ThreadGetRunning();
+  if (thread != NULL) {
+    thread->runtime.switch_out++;
   }
 
-  return (result);
+  thread = osInfo.thread.run.next;
+  thread->runtime.switch_in++;
+  thread->runtime.last_run = osInfo.kernel.tick;
 }
 
 /**
@@ -593,9 +1143,17 @@ bool libThreadDelayTick(void)
  */
 void libThreadSetPriority(osThread_t *thread, int8_t priority)
 {
+  wait_queue_t *wait_que;
+
   if (thread->priority != priority) {
     if (thread->state == ThreadStateBlocked) {
+      /* Move the waiting thread to the list of the new priority */
+      wait_que = thread->wait_queue;
+      ThreadWaitDel(thread);
       thread->priority = priority;
+      if (wait_que != NULL) {
+        ThreadWaitAdd(thread, wait_que);
+      }
     }
     else {
       ThreadReadyDel(thread);
@@ -623,6 +1181,7 @@ osThread_t *libThreadHighestPrioGet(void)
 void libThreadSwitch(osThread_t *thread)
 {
   thread->state = ThreadStateRunning;
+  thread->slice_left = thread->time_slice;
   osInfo.thread.run.next = thread;
   archSwitchContextRequest();
 }
@@ -710,7 +1269,7 @@ osThreadId_t osThreadGetId(void)
     thread_id = ThreadGetId();
   }
   else {
-    thread_id = (osThreadId_t)svc_0((uint32_t)ThreadGetId);
+    thread_id = (osThreadId_t)svc_read_0((uint32_t)ThreadGetId);
   }
 
   return (thread_id);
@@ -730,7 +1289,7 @@ osThreadState_t osThreadGetState(osThreadId_t thread_id)
     state = osThreadError;
   }
   else {
-    state = (osThreadState_t)svc_1((uint32_t)thread_id, (uint32_t)ThreadGetState);
+    state = (osThreadState_t)svc_read_1((uint32_t)thread_id, (uint32_t)ThreadGetState);
   }
 
   return (state);
@@ -776,6 +1335,27 @@ uint32_t osThreadGetStackSpace(osThreadId_t thread_id)
   return (stack_space);
 }
 
+/**
+ * @fn          osStatus_t osThreadGetRuntime(osThreadId_t thread_id, osThreadRuntime_t *runtime)
+ * @brief       Get runtime statistics of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[out]  runtime     pointer to buffer for the runtime statistics.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadGetRuntime(osThreadId_t thread_id, osThreadRuntime_t *runtime)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_2((uint32_t)thread_id, (uint32_t)runtime, (uint32_t)ThreadGetRuntime);
+  }
+
+  return (status);
+}
+
 /**
  * @fn          osStatus_t osThreadSetPriority(osThreadId_t thread_id, osPriority_t priority)
  * @brief       Change priority of a thread.
@@ -876,6 +1456,49 @@ osStatus_t osThreadResume(osThreadId_t thread_id)
   return (status);
 }
 
+/**
+ * @fn          osStatus_t osThreadDetach(osThreadId_t thread_id)
+ * @brief       Detach a thread (thread storage can be reclaimed when thread terminates).
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadDetach(osThreadId_t thread_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)thread_id, (uint32_t)ThreadDetach);
+  }
+
+  return (status);
+}
+
+/**
+ * @fn          osStatus_t osThreadJoin(osThreadId_t thread_id)
+ * @brief       Wait for specified thread to terminate.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @return      status code that indicates the execution status of the function.
+ */
+osStatus_t osThreadJoin(osThreadId_t thread_id)
+{
+  osStatus_t status;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    status = osErrorISR;
+  }
+  else {
+    status = (osStatus_t)svc_1((uint32_t)thread_id, (uint32_t)ThreadJoin);
+    if (status == osThreadWait) {
+      status = (osStatus_t)ThreadGetRunning()->winfo.ret_val;
+    }
+  }
+
+  return (status);
+}
+
 /**
  * @fn          void osThreadExit(void)
  * @brief       Terminate execution of current running thread.
@@ -883,7 +1506,8 @@ osStatus_t osThreadResume(osThreadId_t thread_id)
 __NO_RETURN
 void osThreadExit(void)
 {
-  svc_0((uint32_t)ThreadExit);
+  /* Always through SVC: the thread stack may be released by the call */
+  (svc_0)((uint32_t)ThreadExit);
   for (;;);
 }
 
@@ -900,6 +1524,10 @@ osStatus_t osThreadTerminate(osThreadId_t thread_id)
   if (IsIrqMode() || IsIrqMasked()) {
     status = osErrorISR;
   }
+  else if (thread_id == ThreadGetRunning()) {
+    /* Always through SVC: the thread stack may be released by the call */
+    status = (osStatus_t)(svc_1)((uint32_t)thread_id, (uint32_t)ThreadTerminate);
+  }
   else {
     status = (osStatus_t)svc_1((uint32_t)thread_id, (uint32_t)ThreadTerminate);
   }
@@ -947,4 +1575,95 @@ uint32_t osThreadEnumerate(osThreadId_t *thread_array, uint32_t array_items)
   return (count);
 }
 
+/**
+ * @fn          uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+ * @brief       Set the specified Thread Flags of a thread.
+ * @param[in]   thread_id   thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[in]   flags       specifies the flags of the thread that shall be set.
+ * @return      thread flags after setting or error code if highest bit set.
+ */
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+  uint32_t thread_flags;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    TraceEvent(osTraceIsrCall, (uint32_t)ThreadFlagsSet, (uint32_t)thread_id);
+    if (IsIrqDeferred()) {
+      thread_flags = isrThreadFlagsSet(thread_id, flags);
+    }
+    else {
+      thread_flags = ThreadFlagsSet(thread_id, flags);
+    }
+  }
+  else {
+    thread_flags = svc_2((uint32_t)thread_id, flags, (uint32_t)ThreadFlagsSet);
+  }
+
+  return (thread_flags);
+}
+
+/**
+ * @fn          uint32_t osThreadFlagsClear(uint32_t flags)
+ * @brief       Clear the specified Thread Flags of current running thread.
+ * @param[in]   flags   specifies the flags of the thread that shall be cleared.
+ * @return      thread flags before clearing or error code if highest bit set.
+ */
+uint32_t osThreadFlagsClear(uint32_t flags)
+{
+  uint32_t thread_flags;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    thread_flags = (uint32_t)osErrorISR;
+  }
+  else {
+    thread_flags = svc_1(flags, (uint32_t)ThreadFlagsClear);
+  }
+
+  return (thread_flags);
+}
+
+/**
+ * @fn          uint32_t osThreadFlagsGet(void)
+ * @brief       Get the current Thread Flags of current running thread.
+ * @return      current thread flags.
+ */
+uint32_t osThreadFlagsGet(void)
+{
+  uint32_t thread_flags;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    thread_flags = 0U;
+  }
+  else {
+    thread_flags = svc_read_0((uint32_t)ThreadFlagsGet);
+  }
+
+  return (thread_flags);
+}
+
+/**
+ * @fn          uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
+ * @brief       Wait for one or more Thread Flags of the current running thread to become signaled.
+ * @param[in]   flags     specifies the flags to wait for.
+ * @param[in]   options   specifies flags options (osFlagsXxxx).
+ * @param[in]   timeout   \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @return      thread flags before clearing or error code if highest bit set.
+ */
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  uint32_t thread_flags;
+
+  if (IsIrqMode() || IsIrqMasked()) {
+    thread_flags = (uint32_t)osErrorISR;
+  }
+  else {
+    thread_flags = svc_3(flags, options, timeout, (uint32_t)ThreadFlagsWait);
+    if ((int32_t)thread_flags == osThreadWait) {
+      thread_flags = ThreadGetRunning()->winfo.ret_val;
+    }
+  }
+
+  return (thread_flags);
+}
+
 /* ----------------------------- End of file ---------------------------------*/
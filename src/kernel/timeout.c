@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2019 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: uKernel real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Hierarchical timing wheel for Thread Delays and Timers.
+ *
+ * Level 0 holds entries expiring within the next WHEEL_SIZE ticks, one slot
+ * per tick. Each higher level covers WHEEL_SIZE times the range of the level
+ * below. When the low bits of the wheel tick wrap to zero the matching slot
+ * of the next level is cascaded down, so every entry is moved at most
+ * WHEEL_LEVELS times during its life.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include "os_lib.h"
+
+/*******************************************************************************
+ *  external declarations
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions  (scope: module-exported)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+/**
+ * @brief       Link an entry into the slot matching its expiration time.
+ * @param[out]  timeout   timing wheel entry.
+ */
+static void TimeoutLink(timeout_t *timeout)
+{
+  uint32_t diff;
+  uint32_t level;
+  uint32_t index;
+
+  diff = timeout->time - osInfo.wheel.tick;
+
+  if (diff > 0x7FFFFFFFU) {
+    /* Already expired, process with the next tick */
+    index = osInfo.wheel.tick & WHEEL_MASK;
+    level = 0U;
+  }
+  else {
+    if (diff < WHEEL_SIZE) {
+      level = 0U;
+    }
+    else {
+      level = (31U - __CLZ(diff)) / WHEEL_BITS;
+    }
+    index = (timeout->time >> (level * WHEEL_BITS)) & WHEEL_MASK;
+  }
+
+  timeout->slot = (uint8_t)((level * WHEEL_SIZE) + index);
+  QueueAppend(&osInfo.wheel.slot[level][index], &timeout->que);
+  osInfo.wheel.bmp[level] |= (1UL << index);
+}
+
+/**
+ * @brief       Move entries of the higher level slots due at time one level down.
+ * @param[in]   time  wheel tick with the lowest WHEEL_BITS bits equal to zero.
+ */
+static void TimeoutCascade(uint32_t time)
+{
+  queue_t  *que;
+  uint32_t  index;
+
+  for (uint32_t level = 1U; level < WHEEL_LEVELS; level++) {
+    index = (time >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+    if ((osInfo.wheel.bmp[level] & (1UL << index)) != 0U) {
+      osInfo.wheel.bmp[level] &= ~(1UL << index);
+      que = &osInfo.wheel.slot[level][index];
+      while (!isQueueEmpty(que)) {
+        TimeoutLink(GetTimeoutByQueue(QueueExtract(que)));
+      }
+    }
+
+    if (index != 0U) {
+      break;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Library functions
+ ******************************************************************************/
+
+/**
+ * @brief       Initialize the Timing Wheel.
+ */
+void libTimeoutInit(void)
+{
+  for (uint32_t level = 0U; level < WHEEL_LEVELS; level++) {
+    osInfo.wheel.bmp[level] = 0U;
+    for (uint32_t index = 0U; index < WHEEL_SIZE; index++) {
+      QueueReset(&osInfo.wheel.slot[level][index]);
+    }
+  }
+
+  osInfo.wheel.tick = osInfo.kernel.tick + 1U;
+}
+
+/**
+ * @brief       Insert an entry into the Timing Wheel.
+ * @param[out]  timeout   timing wheel entry.
+ * @param[in]   time      absolute expiration time in ticks.
+ */
+void libTimeoutInsert(timeout_t *timeout, uint32_t time)
+{
+  BEGIN_CRITICAL_SECTION
+
+  timeout->time = time;
+  TimeoutLink(timeout);
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Remove an entry from the Timing Wheel.
+ * @param[out]  timeout   timing wheel entry.
+ */
+void libTimeoutRemove(timeout_t *timeout)
+{
+  uint32_t level;
+  uint32_t index;
+
+  BEGIN_CRITICAL_SECTION
+
+  if (!isQueueEmpty(&timeout->que)) {
+    QueueRemoveEntry(&timeout->que);
+
+    level = timeout->slot / WHEEL_SIZE;
+    index = timeout->slot & WHEEL_MASK;
+    if (isQueueEmpty(&osInfo.wheel.slot[level][index])) {
+      osInfo.wheel.bmp[level] &= ~(1UL << index);
+    }
+  }
+
+  END_CRITICAL_SECTION
+}
+
+/**
+ * @brief       Process expired Thread Delays and Timers up to the current Kernel Tick.
+ * @return      true - Thread dispatch is required, false - otherwise.
+ */
+bool libTimeoutTick(void)
+{
+  timeout_t *timeout;
+  queue_t   *que;
+  uint32_t   index;
+  uint32_t   next;
+  bool       dispatch = false;
+  bool       timer_expired = false;
+
+  while (time_before_eq(osInfo.wheel.tick, osInfo.kernel.tick)) {
+    index = osInfo.wheel.tick & WHEEL_MASK;
+
+    if (index == 0U) {
+      TimeoutCascade(osInfo.wheel.tick);
+    }
+
+    if ((osInfo.wheel.bmp[0] & (1UL << index)) != 0U) {
+      osInfo.wheel.bmp[0] &= ~(1UL << index);
+      que = &osInfo.wheel.slot[0][index];
+      while (!isQueueEmpty(que)) {
+        timeout = GetTimeoutByQueue(QueueExtract(que));
+        if (timeout->owner == ID_THREAD) {
+          TraceEvent(osTraceThreadTimeout, (uint32_t)GetThreadByTimeout(timeout), osInfo.kernel.tick);
+          libThreadWaitTimeout(GetThreadByTimeout(timeout), DISPATCH_NO);
+          dispatch = true;
+        }
+        else {
+          /* Pass Timer to the Timer Thread */
+          TraceEvent(osTraceTimerExpire, (uint32_t)GetTimerByTimeout(timeout), osInfo.kernel.tick);
+          QueueAppend(&osInfo.timer_queue, &timeout->que);
+          timer_expired = true;
+        }
+      }
+    }
+
+    osInfo.wheel.tick++;
+
+    /* Skip ticks up to the next cascade if level 0 is empty */
+    if (osInfo.wheel.bmp[0] == 0U) {
+      next = (osInfo.wheel.tick + WHEEL_MASK) & ~WHEEL_MASK;
+      if (time_after(next, osInfo.kernel.tick)) {
+        next = osInfo.kernel.tick + 1U;
+      }
+      osInfo.wheel.tick = next;
+    }
+  }
+
+  if ((timer_expired != false) && (osInfo.timer_semaphore != NULL)) {
+    osSemaphoreRelease(osInfo.timer_semaphore);
+  }
+
+  return (dispatch);
+}
+
+/**
+ * @brief       Get the number of ticks until the next Timing Wheel event.
+ * @return      number of ticks or osWaitForever if the Timing Wheel is empty.
+ */
+uint32_t libTimeoutNext(void)
+{
+  uint32_t bmp;
+  uint32_t shift;
+  uint32_t start;
+  uint32_t index;
+  uint32_t delay;
+  uint32_t next = osWaitForever;
+
+  for (uint32_t level = 0U; level < WHEEL_LEVELS; level++) {
+    bmp = osInfo.wheel.bmp[level];
+    if (bmp == 0U) {
+      continue;
+    }
+
+    /* First tick at which this level is processed */
+    shift = level * WHEEL_BITS;
+    start = ((osInfo.wheel.tick + ((1UL << shift) - 1U)) >> shift) << shift;
+    index = (start >> shift) & WHEEL_MASK;
+
+    /* Find the nearest non-empty slot */
+    bmp = ((bmp >> index) | (bmp << (WHEEL_SIZE - index))) & ((1UL << WHEEL_SIZE) - 1U);
+    index = 31U - __CLZ(bmp & (0U - bmp));
+
+    delay = (start + (index << shift)) - osInfo.kernel.tick;
+    if (delay < next) {
+      next = delay;
+    }
+  }
+
+  return (next);
+}
+
+/* ----------------------------- End of file ---------------------------------*/
@@ -45,24 +45,26 @@
 
 static osTimerFinfo_t *TimerGetFinfo(void)
 {
-  osTimer_t      *timer;
+  osTimer_t      *timer = NULL;
   osTimerFinfo_t *timer_finfo = NULL;
   queue_t        *timer_queue = &osInfo.timer_queue;
 
+  /* Expired timers are moved here by the timing wheel */
+  BEGIN_CRITICAL_SECTION
+
   if (!isQueueEmpty(timer_queue)) {
-    timer = GetTimerByQueue(timer_queue->next);
-    if (time_after(timer->time, osInfo.kernel.tick)) {
-      timer_finfo = NULL;
+    timer = GetTimerByTimeout(GetTimeoutByQueue(QueueExtract(timer_queue)));
+  }
+
+  END_CRITICAL_SECTION
+
+  if (timer != NULL) {
+    timer_finfo = &timer->finfo;
+    if (timer->type == osTimerPeriodic) {
+      libTimerInsert(timer, timer->load);
     }
     else {
-      libTimerRemove(timer);
-      timer_finfo = &timer->finfo;
-      if (timer->type == osTimerPeriodic) {
-        libTimerInsert(timer, timer->load);
-      }
-      else {
-        timer->state = osTimerStopped;
-      }
+      timer->state = osTimerStopped;
     }
   }
 
@@ -75,31 +77,49 @@ static osTimerFinfo_t *TimerGetFinfo(void)
 
 static osTimerId_t TimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr)
 {
-  osTimer_t *timer;
+  osTimer_t  *timer;
+  const char *name;
+  uint8_t     flags;
 
   /* Check parameters */
-  if ((func == NULL) || (attr == NULL) || ((type != osTimerOnce) && (type != osTimerPeriodic))) {
+  if ((func == NULL) || ((type != osTimerOnce) && (type != osTimerPeriodic))) {
     return NULL;
   }
 
-  timer = attr->cb_mem;
+  if (attr != NULL) {
+    name  = attr->name;
+    timer = attr->cb_mem;
+    /* Check parameters */
+    if ((timer != NULL) && ((((uint32_t)timer & 3U) != 0U) || (attr->cb_size < sizeof(osTimer_t)))) {
+      return (NULL);
+    }
+  }
+  else {
+    name  = NULL;
+    timer = NULL;
+  }
 
-  /* Check parameters */
-  if ((timer == NULL) || (((uint32_t)timer & 3U) != 0U) || (attr->cb_size < sizeof(osTimer_t))) {
-    return (NULL);
+  flags = 0U;
+
+  /* Allocate control block from the Object Memory Pool */
+  if (timer == NULL) {
+    timer = libObjectAlloc(osObjectPoolTimer, sizeof(osTimer_t));
+    if (timer == NULL) {
+      return (NULL);
+    }
+    flags = osFlagSystemObject;
   }
 
   /* Initialize control block */
   timer->id         = ID_TIMER;
   timer->state      = osTimerStopped;
-  timer->flags      = 0U;
+  timer->flags      = flags;
   timer->type       = (uint8_t)type;
-  timer->name       = attr->name;
+  timer->name       = name;
   timer->load       = 0U;
-  timer->time       = 0U;
   timer->finfo.func = func;
   timer->finfo.arg  = argument;
-  QueueReset(&timer->timer_que);
+  TimeoutReset(&timer->timeout, ID_TIMER);
 
   return (timer);
 }
@@ -202,6 +222,11 @@ static osStatus_t TimerDelete(osTimerId_t timer_id)
   timer->state = osTimerInactive;
   timer->id    = ID_INVALID;
 
+  /* Free object memory */
+  if ((timer->flags & osFlagSystemObject) != 0U) {
+    libObjectFree(osObjectPoolTimer, timer);
+  }
+
   return (osOK);
 }
 
@@ -211,24 +236,12 @@ static osStatus_t TimerDelete(osTimerId_t timer_id)
 
 void libTimerInsert(osTimer_t *timer, uint32_t time)
 {
-  queue_t *que;
-  queue_t *timer_queue;
-
-  timer_queue = &osInfo.timer_queue;
-  timer->time = time + osInfo.kernel.tick;
-
-  for (que = timer_queue->next; que != timer_queue; que = que->next) {
-    if (time_before(timer->time, GetTimerByQueue(que)->time)) {
-      break;
-    }
-  }
-
-  QueueAppend(que, &timer->timer_que);
+  libTimeoutInsert(&timer->timeout, osInfo.kernel.tick + time);
 }
 
 void libTimerRemove(osTimer_t *timer)
 {
-  QueueRemoveEntry(&timer->timer_que);
+  libTimeoutRemove(&timer->timeout);
 }
 
 void libTimerThread(void *argument)
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2019 Sergey Koshkin <koshkin.sergey@gmail.com>
+ * All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Project: uKernel real-time kernel
+ */
+
+/**
+ * @file
+ *
+ * Kernel event trace.
+ *
+ * Events are written as fixed-size records into the osTrace ring buffer. The
+ * oldest records are overwritten when the buffer is full. Event classes not
+ * selected in RTOS_Config.h are removed at compile time by TraceEvent().
+ *
+ * SVC events of unprivileged Threads are recorded in Thread mode, where the
+ * critical section has no effect: their records are reserved with exclusive
+ * access (ARMv7-M/ARMv8-M Mainline), so only the timestamps of concurrent
+ * events may appear out of order. The SvcExit record of a blocking call is
+ * written after the wakeup, the ThreadWait record marks where it blocked.
+ *
+ */
+
+/*******************************************************************************
+ *  includes
+ ******************************************************************************/
+
+#include "os_lib.h"
+
+/*******************************************************************************
+ *  external declarations
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  defines and macros (scope: module-local)
+ ******************************************************************************/
+
+#if ((OS_TRACE_BUFFER_SIZE & (OS_TRACE_BUFFER_SIZE - 1)) != 0)
+#error "OS_TRACE_BUFFER_SIZE must be a power of 2"
+#endif
+
+/*******************************************************************************
+ *  typedefs and structures (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions  (scope: module-exported)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  global variable definitions (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function prototypes (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  function implementations (scope: module-local)
+ ******************************************************************************/
+
+/*******************************************************************************
+ *  Library functions
+ ******************************************************************************/
+
+/**
+ * @brief       Initialize the Trace Buffer.
+ */
+void libTraceInit(void)
+{
+#if (OS_TRACE_ENABLE != 0)
+  archCycleCounterInit();
+
+  osTrace.head   = 0U;
+  osTrace.size   = OS_TRACE_BUFFER_SIZE;
+  osTrace.filter = osTraceFilter;
+  osTrace.magic  = osTraceMagic;
+#endif
+}
+
+/**
+ * @brief       Write an event record into the Trace Buffer.
+ * @param[in]   event   event identifier.
+ * @param[in]   arg1    first event argument.
+ * @param[in]   arg2    second event argument.
+ */
+void libTraceRecord(uint32_t event, uint32_t arg1, uint32_t arg2)
+{
+#if (OS_TRACE_ENABLE != 0)
+  osTraceRecord_t *record;
+
+  BEGIN_CRITICAL_SECTION
+
+  /* The critical section has no effect in unprivileged Thread mode (SVC events),
+     reserve the record atomically. Size 0 keeps head a free running counter. */
+  record = &osTrace.record[archAtomicIncWrap((volatile uint32_t *)&osTrace.head, 0U) & (OS_TRACE_BUFFER_SIZE - 1U)];
+
+  record->time  = archCycleCounterGet(osInfo.kernel.tick);
+  record->event = (uint16_t)event;
+  record->ipsr  = (uint16_t)__get_IPSR();
+  record->arg1  = arg1;
+  record->arg2  = arg2;
+
+  END_CRITICAL_SECTION
+#else
+  (void)event;
+  (void)arg1;
+  (void)arg2;
+#endif
+}
+
+/* ----------------------------- End of file ---------------------------------*/
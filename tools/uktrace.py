@@ -0,0 +1,284 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2019 Sergey Koshkin <koshkin.sergey@gmail.com>
+# All rights reserved
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Project: uKernel real-time kernel
+#
+
+"""Decode a uKernel event trace (osTrace) memory dump.
+
+The kernel must be built with OS_TRACE_ENABLE. Dump the osTrace object from
+the target, e.g. with GDB:
+
+    dump binary value trace.bin osTrace
+
+and convert it into a text timeline or a Chrome/Perfetto JSON trace:
+
+    uktrace.py trace.bin --freq 168000000 --nm firmware.sym
+    uktrace.py trace.bin --freq 168000000 --nm firmware.sym --json trace.json
+
+Thread, timer and function addresses are resolved with the output of
+"arm-none-eabi-nm" (--nm) and with explicit --name ADDR=NAME options.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x52544B75
+HEADER = struct.Struct('<4I')
+RECORD = struct.Struct('<IHHII')
+
+EV_THREAD_SWITCH = 0x00
+EV_SVC_ENTER = 0x10
+EV_SVC_EXIT = 0x11
+EV_ISR_CALL = 0x20
+EV_THREAD_WAIT = 0x30
+EV_THREAD_WAKEUP = 0x40
+EV_THREAD_TIMEOUT = 0x50
+EV_TIMER_EXPIRE = 0x51
+
+EVENT_NAMES = {
+    EV_THREAD_SWITCH: 'ThreadSwitch',
+    EV_SVC_ENTER: 'SvcEnter',
+    EV_SVC_EXIT: 'SvcExit',
+    EV_ISR_CALL: 'IsrCall',
+    EV_THREAD_WAIT: 'ThreadWait',
+    EV_THREAD_WAKEUP: 'ThreadWakeup',
+    EV_THREAD_TIMEOUT: 'ThreadTimeout',
+    EV_TIMER_EXPIRE: 'TimerExpire',
+}
+
+OS_WAIT_FOREVER = 0xFFFFFFFF
+
+
+class Symbols:
+    """Address to name resolution."""
+
+    def __init__(self):
+        self.names = {}
+
+    def load_nm(self, path):
+        with open(path) as f:
+            for line in f:
+                fields = line.split()
+                if len(fields) < 3:
+                    continue
+                try:
+                    addr = int(fields[0], 16)
+                except ValueError:
+                    continue
+                # Thumb function addresses have bit 0 set in the trace
+                self.names.setdefault(addr, fields[-1])
+
+    def add(self, spec):
+        addr, _, name = spec.partition('=')
+        self.names[int(addr, 0)] = name
+
+    def __call__(self, addr):
+        if addr == 0:
+            return 'none'
+        name = self.names.get(addr, self.names.get(addr & ~1))
+        return name if name is not None else '0x%08X' % addr
+
+
+def read_records(data):
+    """Return the records of a dump in the order they were written."""
+    if len(data) < HEADER.size:
+        raise ValueError('dump is too short')
+
+    magic, size, head, filt = HEADER.unpack_from(data, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError('invalid trace signature 0x%08X' % magic)
+    if len(data) < HEADER.size + size * RECORD.size:
+        raise ValueError('dump holds less than %u records' % size)
+
+    if head <= size:
+        first, count = 0, head
+    else:
+        first, count = head - size, size
+
+    records = []
+    for n in range(first, first + count):
+        offset = HEADER.size + (n % size) * RECORD.size
+        records.append(RECORD.unpack_from(data, offset))
+
+    return records, head - first, filt
+
+
+def unwrap(records):
+    """Extend the 32-bit cycle counter to a monotonic timestamp."""
+    result = []
+    base = 0
+    last = None
+    for time, event, ipsr, arg1, arg2 in records:
+        if last is not None and time < last:
+            base += 1 << 32
+        last = time
+        result.append((base + time, event, ipsr, arg1, arg2))
+    if result:
+        start = result[0][0]
+        result = [(r[0] - start,) + r[1:] for r in result]
+    return result
+
+
+def describe(event, arg1, arg2, sym):
+    if event == EV_THREAD_SWITCH:
+        return '%s -> %s' % (sym(arg1), sym(arg2))
+    if event == EV_SVC_ENTER:
+        return '%s(0x%08X)' % (sym(arg1), arg2)
+    if event == EV_SVC_EXIT:
+        return '%s = %d' % (sym(arg1), struct.unpack('<i', struct.pack('<I', arg2))[0])
+    if event == EV_ISR_CALL:
+        return '%s(%s)' % (sym(arg1), sym(arg2))
+    if event == EV_THREAD_WAIT:
+        timeout = 'forever' if arg2 == OS_WAIT_FOREVER else '%u ticks' % arg2
+        return '%s timeout %s' % (sym(arg1), timeout)
+    if event == EV_THREAD_WAKEUP:
+        return '%s status %d' % (sym(arg1), struct.unpack('<i', struct.pack('<I', arg2))[0])
+    if event in (EV_THREAD_TIMEOUT, EV_TIMER_EXPIRE):
+        return '%s at tick %u' % (sym(arg1), arg2)
+    return '0x%08X 0x%08X' % (arg1, arg2)
+
+
+def to_us(cycles, freq):
+    return cycles * 1e6 / freq if freq else float(cycles)
+
+
+def write_text(records, freq, sym, out):
+    unit = 'us' if freq else 'cycles'
+    for time, event, ipsr, arg1, arg2 in records:
+        context = 'thread' if ipsr == 0 else 'irq %-3u' % ipsr
+        out.write('%14.3f %s  %-8s %-14s %s\n' % (
+            to_us(time, freq), unit, context,
+            EVENT_NAMES.get(event, 'Event%02X' % event),
+            describe(event, arg1, arg2, sym)))
+
+
+def write_json(records, freq, sym, out):
+    pid = 1
+    events = []
+    threads = set()
+    running = None
+    since = 0.0
+    in_svc = set()
+    blocked = set()
+
+    def tid(thread):
+        threads.add(thread)
+        return thread
+
+    for time, event, ipsr, arg1, arg2 in records:
+        ts = to_us(time, freq)
+
+        if event == EV_THREAD_SWITCH:
+            if running is not None:
+                events.append({'name': 'running', 'ph': 'X', 'pid': pid,
+                               'tid': tid(running), 'ts': since, 'dur': ts - since})
+            running, since = arg2, ts
+            continue
+
+        if ipsr != 0:
+            track = 0x100000000 + ipsr
+            threads.add(track)
+        else:
+            track = tid(running if running is not None else 0)
+
+        if event == EV_SVC_ENTER:
+            in_svc.add(track)
+            events.append({'name': sym(arg1), 'ph': 'B', 'pid': pid, 'tid': track,
+                           'ts': ts, 'args': {'param1': '0x%08X' % arg2}})
+        elif event == EV_SVC_EXIT:
+            in_svc.discard(track)
+            if track in blocked:
+                # The call slice was closed when the thread blocked
+                blocked.discard(track)
+                events.append({'name': 'blocked', 'ph': 'E', 'pid': pid, 'tid': track,
+                               'ts': ts, 'args': {'return': '0x%08X' % arg2}})
+            else:
+                events.append({'name': sym(arg1), 'ph': 'E', 'pid': pid, 'tid': track,
+                               'ts': ts, 'args': {'return': '0x%08X' % arg2}})
+        else:
+            if event in (EV_THREAD_WAIT, EV_THREAD_WAKEUP, EV_THREAD_TIMEOUT):
+                track = tid(arg1)
+            if event == EV_THREAD_WAIT and track in in_svc and track not in blocked:
+                # SvcExit of a blocking call follows the wakeup: split off the blocked time
+                blocked.add(track)
+                events.append({'name': 'call', 'ph': 'E', 'pid': pid, 'tid': track, 'ts': ts})
+                events.append({'name': 'blocked', 'ph': 'B', 'pid': pid, 'tid': track, 'ts': ts})
+            events.append({'name': EVENT_NAMES.get(event, 'Event%02X' % event),
+                           'ph': 'i', 's': 't', 'pid': pid, 'tid': track, 'ts': ts,
+                           'args': {'info': describe(event, arg1, arg2, sym)}})
+
+    if running is not None and records:
+        ts = to_us(records[-1][0], freq)
+        events.append({'name': 'running', 'ph': 'X', 'pid': pid,
+                       'tid': tid(running), 'ts': since, 'dur': ts - since})
+
+    events.append({'name': 'process_name', 'ph': 'M', 'pid': pid,
+                   'args': {'name': 'uKernel'}})
+    for thread in sorted(threads):
+        if thread >= 0x100000000:
+            name = 'IRQ %u' % (thread - 0x100000000)
+        else:
+            name = sym(thread)
+        events.append({'name': 'thread_name', 'ph': 'M', 'pid': pid, 'tid': thread,
+                       'args': {'name': name}})
+
+    json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, out, indent=1)
+    out.write('\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('dump', help='binary dump of the osTrace object')
+    parser.add_argument('--freq', type=float, default=0.0,
+                        help='cycle counter frequency in Hz (timestamps in cycles if omitted)')
+    parser.add_argument('--nm', action='append', default=[],
+                        help='symbol table produced by nm')
+    parser.add_argument('--name', action='append', default=[], metavar='ADDR=NAME',
+                        help='name for a thread, object or function address')
+    parser.add_argument('--json', metavar='FILE',
+                        help='write a Chrome/Perfetto JSON trace instead of text')
+    args = parser.parse_args()
+
+    sym = Symbols()
+    for path in args.nm:
+        sym.load_nm(path)
+    for spec in args.name:
+        sym.add(spec)
+
+    with open(args.dump, 'rb') as f:
+        data = f.read()
+
+    try:
+        records, count, filt = read_records(data)
+    except ValueError as err:
+        sys.exit('uktrace: %s' % err)
+
+    records = unwrap(records)
+    sys.stderr.write('uktrace: %u records, event classes 0x%02X\n' % (count, filt))
+
+    if args.json:
+        with open(args.json, 'w') as out:
+            write_json(records, args.freq, sym, out)
+    else:
+        write_text(records, args.freq, sym, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()